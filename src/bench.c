@@ -0,0 +1,204 @@
+// This is a personal academic project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: https://pvs-studio.com
+#define _GNU_SOURCE
+#include "lib/common.h"
+#include "lib/game_logic.h"
+#include "lib/library.h"
+#include "lib/memory_management.h"
+#include "lib/player_functions.h"
+#include "lib/view_functions.h"
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+/*
+ * Microbenchmarks de las funciones del camino caliente (make bench).
+ *
+ * Cada benchmark corre en memoria privada, sin procesos ni memoria compartida, sobre un tablero generado con una
+ * semilla fija. Se repite BENCH_REPETITIONS veces y se informa el minimo, la mediana y el maximo de ns por
+ * operacion en CSV, para poder comparar corridas.
+ */
+
+#define BENCH_SEED 12345
+#define BENCH_REPETITIONS 5
+#define BENCH_TARGET_NS 200000000ULL // Tiempo aproximado de cada repeticion
+
+typedef void (*bench_fn_t)(void *arg, unsigned long long iterations);
+
+// Contexto de un tablero de benchmark
+typedef struct {
+	master_context_t master;
+	view_context_t view;
+	player_context_t player;
+	game_sync_t sync;
+	char *names[MAX_PLAYERS];
+} bench_board_t;
+
+static volatile unsigned long long sink; // Evita que se descarten los resultados
+
+static unsigned long long now_ns(void) {
+	struct timespec now;
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return (unsigned long long) now.tv_sec * 1000000000ULL + (unsigned long long) now.tv_nsec;
+}
+
+static void bench_is_valid_move(void *arg, unsigned long long iterations) {
+	bench_board_t *board = arg;
+	const game_state_t *state = board->master.game_state;
+	unsigned long long valid = 0;
+	for (unsigned long long i = 0; i < iterations; i++) {
+		valid += is_valid_move((int) (i % state->player_count), (unsigned char) (i % 8), state);
+	}
+	sink = valid;
+}
+
+static void bench_check_game_end(void *arg, unsigned long long iterations) {
+	bench_board_t *board = arg;
+	unsigned long long ended = 0;
+	for (unsigned long long i = 0; i < iterations; i++) {
+		ended += check_game_end(&board->master);
+	}
+	sink = ended;
+}
+
+static void bench_initialize_game_state(void *arg, unsigned long long iterations) {
+	bench_board_t *board = arg;
+	for (unsigned long long i = 0; i < iterations; i++) {
+		initialize_game_state(&board->master);
+	}
+	sink = (unsigned long long) board->master.game_state->board[0];
+}
+
+static void bench_print_game_state(void *arg, unsigned long long iterations) {
+	bench_board_t *board = arg;
+	for (unsigned long long i = 0; i < iterations; i++) {
+		print_game_state(&board->view);
+	}
+}
+
+static void bench_read_lock(void *arg, unsigned long long iterations) {
+	bench_board_t *board = arg;
+	for (unsigned long long i = 0; i < iterations; i++) {
+		enter_read_state(&board->player);
+		exit_read_state(&board->player);
+	}
+}
+
+static int compare_double(const void *a, const void *b) {
+	double x = *(const double *) a, y = *(const double *) b;
+	return (x > y) - (x < y);
+}
+
+/**
+ * @brief Calibra la cantidad de iteraciones y mide BENCH_REPETITIONS repeticiones
+ * @param out Stream del CSV
+ * @param name Nombre del benchmark
+ * @param fn Funcion a medir
+ * @param board Tablero
+ */
+static void run_bench(FILE *out, const char *name, bench_fn_t fn, bench_board_t *board) {
+	// Se duplican las iteraciones hasta que una corrida tarde al menos 1/10 del objetivo
+	unsigned long long iterations = 1;
+	unsigned long long elapsed = 0;
+	while (elapsed < BENCH_TARGET_NS / 10 && iterations < (1ULL << 40)) {
+		iterations *= 2;
+		unsigned long long start = now_ns();
+		fn(board, iterations);
+		elapsed = now_ns() - start;
+	}
+	iterations = (unsigned long long) ((double) iterations * BENCH_TARGET_NS / (elapsed > 0 ? elapsed : 1));
+	if (iterations == 0) {
+		iterations = 1;
+	}
+
+	double ns_per_op[BENCH_REPETITIONS];
+	for (int rep = 0; rep < BENCH_REPETITIONS; rep++) {
+		unsigned long long start = now_ns();
+		fn(board, iterations);
+		ns_per_op[rep] = (double) (now_ns() - start) / iterations;
+	}
+	qsort(ns_per_op, BENCH_REPETITIONS, sizeof(double), compare_double);
+
+	const game_state_t *state = board->master.game_state;
+	fprintf(out, "%s,%u,%u,%u,%llu,%d,%.2f,%.2f,%.2f\n", name, state->width, state->height, state->player_count,
+			iterations, BENCH_REPETITIONS, ns_per_op[0], ns_per_op[BENCH_REPETITIONS / 2],
+			ns_per_op[BENCH_REPETITIONS - 1]);
+	fflush(out);
+}
+
+/**
+ * @brief Prepara un tablero en memoria privada con semaforos locales
+ * @return 0 si se pudo reservar la memoria, -1 si no
+ */
+static int setup_board(bench_board_t *board, int width, int height, int players) {
+	memset(board, 0, sizeof(*board));
+	for (int i = 0; i < players; i++) {
+		board->names[i] = "bench";
+	}
+
+	master_context_t *master = &board->master;
+	master->config.width = width;
+	master->config.height = height;
+	master->config.player_count = players;
+	master->config.seed = BENCH_SEED;
+	master->config.player_paths = board->names;
+	master->game_state = malloc(calculate_game_state_size(width, height));
+	if (master->game_state == NULL)
+		return -1;
+	initialize_game_state(master);
+
+	sem_init(&board->sync.reader_writer_mutex, 0, 1);
+	sem_init(&board->sync.state_mutex, 0, 1);
+	sem_init(&board->sync.reader_count_mutex, 0, 1);
+	master->game_sync = &board->sync;
+
+	board->view.game_state = master->game_state;
+	board->view.game_sync = &board->sync;
+	board->player.game_state = master->game_state;
+	board->player.game_sync = &board->sync;
+	return 0;
+}
+
+static void free_board(bench_board_t *board) {
+	sem_destroy(&board->sync.reader_writer_mutex);
+	sem_destroy(&board->sync.state_mutex);
+	sem_destroy(&board->sync.reader_count_mutex);
+	free(board->master.game_state);
+}
+
+int main(void) {
+	static const int sizes[] = {10, 50, 200};
+	static const int player_counts[] = {1, 9};
+
+	// print_game_state escribe en stdout: se redirige a /dev/null y el CSV sale por una copia del stdout original
+	int out_fd = dup(STDOUT_FILENO);
+	FILE *out = (out_fd != -1) ? fdopen(out_fd, "w") : NULL;
+	if (out == NULL || freopen("/dev/null", "w", stdout) == NULL) {
+		perror("Error redirecting stdout");
+		return EXIT_FAILURE;
+	}
+
+	fprintf(out, "benchmark,width,height,players,iterations,repetitions,min_ns,median_ns,max_ns\n");
+	for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++) {
+		for (size_t p = 0; p < sizeof(player_counts) / sizeof(player_counts[0]); p++) {
+			bench_board_t board;
+			if (setup_board(&board, sizes[s], sizes[s], player_counts[p]) != 0) {
+				perror("Error allocating benchmark board");
+				return EXIT_FAILURE;
+			}
+
+			run_bench(out, "is_valid_move", bench_is_valid_move, &board);
+			run_bench(out, "check_game_end", bench_check_game_end, &board);
+			run_bench(out, "initialize_game_state", bench_initialize_game_state, &board);
+			run_bench(out, "print_game_state", bench_print_game_state, &board);
+			run_bench(out, "read_lock", bench_read_lock, &board);
+			free_board(&board);
+		}
+	}
+
+	fclose(out);
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,150 @@
+// This is a personal academic project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: https://pvs-studio.com
+#define _GNU_SOURCE
+#include "lib/common.h"
+#include "lib/library.h"
+#include "lib/live_stats.h"
+#include <errno.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#define DEFAULT_INTERVAL_MS 1000
+#define CLEAR_SCREEN "\033[H\033[2J"
+
+// Copia de los contadores en un instante
+typedef struct {
+	unsigned long long taken_ns;
+	unsigned long long tick;
+	unsigned long long moves[MAX_PLAYERS];
+	unsigned long long invalid[MAX_PLAYERS];
+	unsigned long long score[MAX_PLAYERS];
+	unsigned long long view_frames;
+	unsigned long long lock_wait_ns;
+	long long last_valid_move;
+	unsigned int finished;
+} snapshot_t;
+
+static unsigned long long now_ns(void) {
+	struct timespec now;
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return (unsigned long long) now.tv_sec * 1000000000ULL + (unsigned long long) now.tv_nsec;
+}
+
+/**
+ * @brief Lee cada contador con una carga atomica (el master puede estar escribiendo)
+ */
+static void take_snapshot(const game_live_stats_t *stats, snapshot_t *snapshot) {
+	snapshot->taken_ns = now_ns();
+	snapshot->finished = __atomic_load_n(&stats->finished, __ATOMIC_ACQUIRE);
+	snapshot->tick = __atomic_load_n(&stats->tick, __ATOMIC_RELAXED);
+	for (unsigned int i = 0; i < stats->player_count && i < MAX_PLAYERS; i++) {
+		snapshot->moves[i] = __atomic_load_n(&stats->moves[i], __ATOMIC_RELAXED);
+		snapshot->invalid[i] = __atomic_load_n(&stats->invalid[i], __ATOMIC_RELAXED);
+		snapshot->score[i] = __atomic_load_n(&stats->score[i], __ATOMIC_RELAXED);
+	}
+	snapshot->view_frames = __atomic_load_n(&stats->view_frames, __ATOMIC_RELAXED);
+	snapshot->lock_wait_ns = __atomic_load_n(&stats->lock_wait_ns, __ATOMIC_RELAXED);
+	snapshot->last_valid_move = __atomic_load_n(&stats->last_valid_move, __ATOMIC_RELAXED);
+}
+
+/**
+ * @brief Tasa por segundo de un contador entre dos lecturas
+ */
+static double rate(unsigned long long current, unsigned long long previous, double seconds) {
+	return (seconds > 0.0 && current >= previous) ? (current - previous) / seconds : 0.0;
+}
+
+/**
+ * @brief Imprime una pantalla con los totales y las tasas desde la lectura anterior
+ */
+static void print_screen(const game_live_stats_t *stats, const snapshot_t *now, const snapshot_t *prev, bool batch) {
+	double seconds = (now->taken_ns - prev->taken_ns) / 1e9;
+	double uptime = (now->taken_ns - stats->start_ns) / 1e9;
+	double idle = difftime(time(NULL), (time_t) now->last_valid_move);
+
+	if (!batch) {
+		printf(CLEAR_SCREEN);
+	}
+	printf("chompstat - master %d, up %.0f s, %s\n", stats->master_pid, uptime,
+		   now->finished ? "finished" : "running");
+	printf("Tick: %llu   Moves/s: %.1f   View fps: %.1f   Idle: %.0f/%u s\n", now->tick,
+		   rate(now->tick, prev->tick, seconds), rate(now->view_frames, prev->view_frames, seconds), idle,
+		   stats->timeout);
+	printf("Writer lock wait: %.3f ms total, %.2f us per move\n", now->lock_wait_ns / 1e6,
+		   now->tick > 0 ? now->lock_wait_ns / 1e3 / now->tick : 0.0);
+
+	printf("\n%-3s %-16s %10s %9s %8s %10s\n", "ID", "Name", "Moves", "Moves/s", "Invalid", "Score");
+	for (unsigned int i = 0; i < stats->player_count && i < MAX_PLAYERS; i++) {
+		double invalid = now->moves[i] > 0 ? 100.0 * now->invalid[i] / now->moves[i] : 0.0;
+		printf("%-3u %-16.*s %10llu %9.1f %7.1f%% %10llu\n", i + 1, MAX_NAME_LEN, stats->names[i], now->moves[i],
+			   rate(now->moves[i], prev->moves[i], seconds), invalid, now->score[i]);
+	}
+	fflush(stdout);
+}
+
+static void usage(const char *program) {
+	fprintf(stderr, "Usage: %s [-i interval_ms] [-n count] [-b]\n", program);
+	fprintf(stderr, "  Attaches read-only to %s (master --live-stats) and refreshes like top\n",
+			shm_name(GAME_LIVE_STATS_SHM));
+}
+
+int main(int argc, char *argv[]) {
+	int interval_ms = DEFAULT_INTERVAL_MS;
+	int count = 0; // 0: hasta que termine la partida
+	bool batch = false;
+
+	for (int i = 1; i < argc; i++) {
+		if (strcmp(argv[i], "-i") == 0 && i + 1 < argc) {
+			interval_ms = atoi(argv[++i]);
+		}
+		else if (strcmp(argv[i], "-n") == 0 && i + 1 < argc) {
+			count = atoi(argv[++i]);
+		}
+		else if (strcmp(argv[i], "-b") == 0) {
+			batch = true;
+		}
+		else {
+			usage(argv[0]);
+			return EXIT_FAILURE;
+		}
+	}
+	if (interval_ms <= 0 || count < 0) {
+		usage(argv[0]);
+		return EXIT_FAILURE;
+	}
+
+	const game_live_stats_t *stats = live_stats_connect();
+	if (stats == NULL) {
+		fprintf(stderr, "Error: No game is publishing %s (start master with --live-stats)\n",
+				shm_name(GAME_LIVE_STATS_SHM));
+		return EXIT_FAILURE;
+	}
+
+	// La primera pantalla muestra tasas desde el inicio de la partida
+	snapshot_t prev, now;
+	memset(&prev, 0, sizeof(prev));
+	prev.taken_ns = stats->start_ns;
+
+	for (int screen = 0; count == 0 || screen < count; screen++) {
+		if (screen > 0) {
+			usleep((useconds_t) interval_ms * 1000);
+		}
+		take_snapshot(stats, &now);
+		print_screen(stats, &now, &prev, batch);
+		prev = now;
+
+		// El segmento sigue mapeado despues del shm_unlink del master: se muestra el estado final y se sale
+		if (now.finished)
+			break;
+		if (kill(stats->master_pid, 0) == -1 && errno == ESRCH) {
+			printf("Master %d exited\n", stats->master_pid);
+			break;
+		}
+	}
+
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,509 @@
+// This is a personal academic project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: https://pvs-studio.com
+#define _GNU_SOURCE
+#include "lib/histogram.h"
+#include <errno.h>
+#include <linux/futex.h>
+#include <sched.h>
+#include <semaphore.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/eventfd.h>
+#include <sys/mman.h>
+#include <sys/select.h>
+#include <sys/socket.h>
+#include <sys/syscall.h>
+#include <sys/wait.h>
+#include <time.h>
+#include <unistd.h>
+
+/*
+ * Benchmark de transportes para el protocolo de turnos (make bench).
+ *
+ * Reproduce el intercambio de process_player_moves / player_main_loop sin el juego: cada jugador espera su turno,
+ * envia un byte y vuelve a esperar; el master espera a que algun jugador tenga un movimiento, lo toma rotando
+ * desde current_player (uno por iteracion) y le devuelve el turno. Cada jugador mide el ida y vuelta desde que
+ * envia el movimiento hasta que recibe el turno siguiente, y el master mide el throughput total.
+ *
+ * Transportes:
+ *   pipe        pipe por jugador + sem_t de turno (el protocolo actual, con select)
+ *   socketpair  socket AF_UNIX por jugador en ambos sentidos (el turno es un byte de vuelta)
+ *   eventfd     movimiento en un lugar compartido + eventfd por jugador en cada sentido
+ *   futex       anillo SPSC por jugador + futex compartido para despertar al master y futex de turno
+ *   busypoll    los mismos anillos y contadores, esperando con spin y sched_yield en lugar de futex
+ */
+
+#define DEFAULT_TOTAL_MOVES 20000
+#define MAX_BENCH_PLAYERS 64
+#define RING_SIZE 64 // Potencia de dos
+#define POLL_YIELD_INTERVAL 64
+
+// Anillo SPSC de movimientos (jugador -> master)
+typedef struct {
+	unsigned int head;				// Escrito solo por el jugador
+	unsigned int tail;				// Escrito solo por el master
+	unsigned char moves[RING_SIZE]; // Movimientos pendientes
+} move_ring_t;
+
+// Memoria compartida entre el master y los jugadores
+typedef struct {
+	sem_t turn_sem[MAX_BENCH_PLAYERS];	   // pipe: semaforo de turno
+	unsigned char slot[MAX_BENCH_PLAYERS]; // eventfd: movimiento enviado
+	move_ring_t rings[MAX_BENCH_PLAYERS];  // futex/busypoll: movimientos pendientes
+	uint32_t turns[MAX_BENCH_PLAYERS];	   // futex/busypoll: turnos otorgados a cada jugador
+	uint32_t master_seq;				   // futex/busypoll: movimientos enviados (despierta al master)
+	histogram_t rtt[MAX_BENCH_PLAYERS];	   // Ida y vuelta de cada jugador
+} shared_t;
+
+typedef struct bench bench_t;
+
+// Operaciones de un transporte
+typedef struct {
+	const char *name;
+	int (*setup)(bench_t *bench);										// Antes del fork
+	void (*send)(bench_t *bench, int id, unsigned char move);			// Jugador: envia el movimiento
+	void (*wait_turn)(bench_t *bench, int id);							// Jugador: espera el turno
+	int (*next_move)(bench_t *bench, int current, unsigned char *move); // Master: jugador con movimiento
+	void (*grant)(bench_t *bench, int id);								// Master: devuelve el turno
+	void (*teardown)(bench_t *bench);									// Libera los descriptores
+} transport_t;
+
+struct bench {
+	const transport_t *transport;
+	int players;
+	shared_t *shared;
+	int to_master[MAX_BENCH_PLAYERS]; // Movimientos: lado del master (pipe, socket) o eventfd
+	int to_player[MAX_BENCH_PLAYERS]; // Lado del jugador (pipe, socket) o eventfd de turno
+	uint32_t consumed;				  // Jugador: turnos ya consumidos (futex/busypoll)
+};
+
+static unsigned long long now_ns(void) {
+	struct timespec now;
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return (unsigned long long) now.tv_sec * 1000000000ULL + (unsigned long long) now.tv_nsec;
+}
+
+static void cpu_relax(void) {
+#if defined(__x86_64__) || defined(__i386__)
+	__builtin_ia32_pause();
+#elif defined(__aarch64__)
+	__asm__ __volatile__("yield");
+#endif
+}
+
+static void futex_wait(uint32_t *word, uint32_t expected) {
+	syscall(SYS_futex, word, FUTEX_WAIT, expected, NULL, NULL, 0);
+}
+
+static void futex_wake(uint32_t *word) {
+	syscall(SYS_futex, word, FUTEX_WAKE, 1, NULL, NULL, 0);
+}
+
+static void close_fds(bench_t *bench) {
+	for (int i = 0; i < bench->players; i++) {
+		if (bench->to_master[i] >= 0) {
+			close(bench->to_master[i]);
+		}
+		if (bench->to_player[i] >= 0 && bench->to_player[i] != bench->to_master[i]) {
+			close(bench->to_player[i]);
+		}
+	}
+}
+
+/**
+ * @brief Como el select de game_loop: espera algun descriptor listo y toma el primero desde current
+ */
+static int select_next(bench_t *bench, int current, unsigned char *move, bool eventfd_slot) {
+	while (true) {
+		fd_set readfds;
+		FD_ZERO(&readfds);
+		int max_fd = 0;
+		for (int i = 0; i < bench->players; i++) {
+			FD_SET(bench->to_master[i], &readfds);
+			max_fd = (bench->to_master[i] > max_fd) ? bench->to_master[i] : max_fd;
+		}
+		if (select(max_fd + 1, &readfds, NULL, NULL, NULL) <= 0)
+			continue;
+
+		for (int attempts = 0; attempts < bench->players; attempts++) {
+			int id = (current + attempts) % bench->players;
+			if (!FD_ISSET(bench->to_master[id], &readfds))
+				continue;
+			if (eventfd_slot) {
+				uint64_t value;
+				if (read(bench->to_master[id], &value, sizeof(value)) != sizeof(value))
+					continue;
+				*move = bench->shared->slot[id];
+			}
+			else if (read(bench->to_master[id], move, 1) != 1) {
+				continue;
+			}
+			return id;
+		}
+	}
+}
+
+// pipe + sem_t
+
+static int pipe_setup(bench_t *bench) {
+	for (int i = 0; i < bench->players; i++) {
+		int fds[2];
+		if (pipe(fds) == -1 || sem_init(&bench->shared->turn_sem[i], 1, 0) == -1)
+			return -1;
+		bench->to_master[i] = fds[0];
+		bench->to_player[i] = fds[1];
+	}
+	return 0;
+}
+
+static void pipe_send(bench_t *bench, int id, unsigned char move) {
+	if (write(bench->to_player[id], &move, 1) != 1) {
+		perror("write");
+	}
+}
+
+static void pipe_wait_turn(bench_t *bench, int id) {
+	while (sem_wait(&bench->shared->turn_sem[id]) == -1 && errno == EINTR) {
+	}
+}
+
+static int pipe_next(bench_t *bench, int current, unsigned char *move) {
+	return select_next(bench, current, move, false);
+}
+
+static void pipe_grant(bench_t *bench, int id) {
+	sem_post(&bench->shared->turn_sem[id]);
+}
+
+static void pipe_teardown(bench_t *bench) {
+	close_fds(bench);
+	for (int i = 0; i < bench->players; i++) {
+		sem_destroy(&bench->shared->turn_sem[i]);
+	}
+}
+
+// socketpair
+
+static int socket_setup(bench_t *bench) {
+	for (int i = 0; i < bench->players; i++) {
+		int fds[2];
+		if (socketpair(AF_UNIX, SOCK_STREAM, 0, fds) == -1)
+			return -1;
+		bench->to_master[i] = fds[0]; // Extremo del master
+		bench->to_player[i] = fds[1]; // Extremo del jugador
+	}
+	return 0;
+}
+
+static void socket_send(bench_t *bench, int id, unsigned char move) {
+	if (write(bench->to_player[id], &move, 1) != 1) {
+		perror("write");
+	}
+}
+
+static void socket_wait_turn(bench_t *bench, int id) {
+	unsigned char turn;
+	while (read(bench->to_player[id], &turn, 1) == -1 && errno == EINTR) {
+	}
+}
+
+static void socket_grant(bench_t *bench, int id) {
+	unsigned char turn = 1;
+	if (write(bench->to_master[id], &turn, 1) != 1) {
+		perror("write");
+	}
+}
+
+// eventfd + lugar compartido
+
+static int eventfd_setup(bench_t *bench) {
+	for (int i = 0; i < bench->players; i++) {
+		bench->to_master[i] = eventfd(0, 0);
+		bench->to_player[i] = eventfd(0, 0);
+		if (bench->to_master[i] == -1 || bench->to_player[i] == -1)
+			return -1;
+	}
+	return 0;
+}
+
+static void eventfd_send(bench_t *bench, int id, unsigned char move) {
+	uint64_t one = 1;
+	bench->shared->slot[id] = move;
+	if (write(bench->to_master[id], &one, sizeof(one)) != sizeof(one)) {
+		perror("write");
+	}
+}
+
+static void eventfd_wait_turn(bench_t *bench, int id) {
+	uint64_t value;
+	while (read(bench->to_player[id], &value, sizeof(value)) == -1 && errno == EINTR) {
+	}
+}
+
+static int eventfd_next(bench_t *bench, int current, unsigned char *move) {
+	return select_next(bench, current, move, true);
+}
+
+static void eventfd_grant(bench_t *bench, int id) {
+	uint64_t one = 1;
+	if (write(bench->to_player[id], &one, sizeof(one)) != sizeof(one)) {
+		perror("write");
+	}
+}
+
+// Anillos SPSC (futex y busypoll)
+
+static int ring_setup(bench_t *bench) {
+	memset(bench->shared->rings, 0, sizeof(bench->shared->rings));
+	memset(bench->shared->turns, 0, sizeof(bench->shared->turns));
+	bench->shared->master_seq = 0;
+	return 0;
+}
+
+static void ring_push(bench_t *bench, int id, unsigned char move) {
+	move_ring_t *ring = &bench->shared->rings[id];
+	unsigned int head = ring->head;
+	ring->moves[head & (RING_SIZE - 1)] = move;
+	__atomic_store_n(&ring->head, head + 1, __ATOMIC_RELEASE);
+	__atomic_fetch_add(&bench->shared->master_seq, 1, __ATOMIC_RELEASE);
+}
+
+/**
+ * @brief Toma el primer movimiento pendiente desde current (rotacion de process_player_moves)
+ * @return Jugador, o -1 si no hay movimientos
+ */
+static int ring_pop(bench_t *bench, int current, unsigned char *move) {
+	for (int attempts = 0; attempts < bench->players; attempts++) {
+		int id = (current + attempts) % bench->players;
+		move_ring_t *ring = &bench->shared->rings[id];
+		unsigned int tail = ring->tail;
+		if (__atomic_load_n(&ring->head, __ATOMIC_ACQUIRE) == tail)
+			continue;
+		*move = ring->moves[tail & (RING_SIZE - 1)];
+		__atomic_store_n(&ring->tail, tail + 1, __ATOMIC_RELEASE);
+		return id;
+	}
+	return -1;
+}
+
+static void futex_send(bench_t *bench, int id, unsigned char move) {
+	ring_push(bench, id, move);
+	futex_wake(&bench->shared->master_seq);
+}
+
+static void futex_wait_turn(bench_t *bench, int id) {
+	uint32_t *turns = &bench->shared->turns[id];
+	uint32_t granted;
+	while ((granted = __atomic_load_n(turns, __ATOMIC_ACQUIRE)) == bench->consumed) {
+		futex_wait(turns, granted);
+	}
+	bench->consumed++;
+}
+
+static int futex_next(bench_t *bench, int current, unsigned char *move) {
+	while (true) {
+		uint32_t seq = __atomic_load_n(&bench->shared->master_seq, __ATOMIC_ACQUIRE);
+		int id = ring_pop(bench, current, move);
+		if (id >= 0)
+			return id;
+		futex_wait(&bench->shared->master_seq, seq);
+	}
+}
+
+static void futex_grant(bench_t *bench, int id) {
+	__atomic_fetch_add(&bench->shared->turns[id], 1, __ATOMIC_RELEASE);
+	futex_wake(&bench->shared->turns[id]);
+}
+
+static void poll_send(bench_t *bench, int id, unsigned char move) {
+	ring_push(bench, id, move);
+}
+
+static void poll_wait_turn(bench_t *bench, int id) {
+	unsigned int spins = 0;
+	while (__atomic_load_n(&bench->shared->turns[id], __ATOMIC_ACQUIRE) == bench->consumed) {
+		cpu_relax();
+		if (++spins % POLL_YIELD_INTERVAL == 0) {
+			sched_yield(); // Con menos CPUs que procesos el que espera tiene que ceder la CPU
+		}
+	}
+	bench->consumed++;
+}
+
+static int poll_next(bench_t *bench, int current, unsigned char *move) {
+	unsigned int spins = 0;
+	while (true) {
+		int id = ring_pop(bench, current, move);
+		if (id >= 0)
+			return id;
+		cpu_relax();
+		if (++spins % POLL_YIELD_INTERVAL == 0) {
+			sched_yield();
+		}
+	}
+}
+
+static void poll_grant(bench_t *bench, int id) {
+	__atomic_fetch_add(&bench->shared->turns[id], 1, __ATOMIC_RELEASE);
+}
+
+static void no_teardown(bench_t *bench) {
+	(void) bench;
+}
+
+static const transport_t transports[] = {
+	{"pipe", pipe_setup, pipe_send, pipe_wait_turn, pipe_next, pipe_grant, pipe_teardown},
+	{"socketpair", socket_setup, socket_send, socket_wait_turn, pipe_next, socket_grant, close_fds},
+	{"eventfd", eventfd_setup, eventfd_send, eventfd_wait_turn, eventfd_next, eventfd_grant, close_fds},
+	{"futex", ring_setup, futex_send, futex_wait_turn, futex_next, futex_grant, no_teardown},
+	{"busypoll", ring_setup, poll_send, poll_wait_turn, poll_next, poll_grant, no_teardown},
+};
+
+/**
+ * @brief Bucle de un jugador: turno inicial y luego moves veces enviar y esperar el turno siguiente
+ */
+static void player_loop(bench_t *bench, int id, int moves) {
+	const transport_t *transport = bench->transport;
+	histogram_t *rtt = &bench->shared->rtt[id];
+
+	transport->wait_turn(bench, id);
+	for (int i = 0; i < moves; i++) {
+		unsigned long long sent = now_ns();
+		transport->send(bench, id, (unsigned char) (i % 8));
+		transport->wait_turn(bench, id);
+		histogram_record(rtt, now_ns() - sent);
+	}
+}
+
+/**
+ * @brief Corre una configuracion e imprime una fila CSV
+ * @return 0 si termino bien, -1 si no se pudo preparar
+ */
+static int run_config(const transport_t *transport, int players, int total_moves, shared_t *shared) {
+	bench_t bench;
+	memset(&bench, 0, sizeof(bench));
+	memset(shared, 0, sizeof(*shared));
+	bench.transport = transport;
+	bench.players = players;
+	bench.shared = shared;
+	for (int i = 0; i < MAX_BENCH_PLAYERS; i++) {
+		bench.to_master[i] = bench.to_player[i] = -1;
+	}
+
+	if (transport->setup(&bench) != 0) {
+		perror(transport->name);
+		transport->teardown(&bench);
+		return -1;
+	}
+
+	int moves = (total_moves + players - 1) / players;
+	pid_t pids[MAX_BENCH_PLAYERS];
+	for (int i = 0; i < players; i++) {
+		pids[i] = fork();
+		if (pids[i] == 0) {
+			player_loop(&bench, i, moves);
+			_exit(EXIT_SUCCESS);
+		}
+	}
+
+	// Turno inicial para todos, como run_process_game
+	unsigned long long start = now_ns();
+	for (int i = 0; i < players; i++) {
+		transport->grant(&bench, i);
+	}
+
+	int current = 0;
+	for (long processed = 0; processed < (long) moves * players; processed++) {
+		unsigned char move;
+		int id = transport->next_move(&bench, current, &move);
+		transport->grant(&bench, id);
+		current = (id + 1) % players;
+	}
+	double seconds = (now_ns() - start) / 1e9;
+
+	for (int i = 0; i < players; i++) {
+		waitpid(pids[i], NULL, 0);
+	}
+	transport->teardown(&bench);
+
+	// Distribucion conjunta de todos los jugadores
+	histogram_t *all = &shared->rtt[0];
+	for (int i = 1; i < players; i++) {
+		histogram_merge(all, &shared->rtt[i]);
+	}
+
+	printf("%s,%d,%ld,%.0f,%.2f,%.2f,%.2f,%.2f,%.2f\n", transport->name, players, (long) moves * players,
+		   moves * players / seconds, all->count > 0 ? all->sum / 1000.0 / all->count : 0.0,
+		   histogram_percentile(all, 50) / 1000.0, histogram_percentile(all, 90) / 1000.0,
+		   histogram_percentile(all, 99) / 1000.0, all->max / 1000.0);
+	fflush(stdout);
+	return 0;
+}
+
+static void usage(const char *program) {
+	fprintf(stderr, "Usage: %s [-m total_moves] [-t transport] [players ...]\n", program);
+	fprintf(stderr, "  Transports: pipe, socketpair, eventfd, futex, busypoll (default: all)\n");
+	fprintf(stderr, "  Players: default 1 2 3 5 9 16 32 (max %d)\n", MAX_BENCH_PLAYERS);
+}
+
+int main(int argc, char *argv[]) {
+	int total_moves = DEFAULT_TOTAL_MOVES;
+	const char *only = NULL;
+	int player_counts[MAX_BENCH_PLAYERS] = {1, 2, 3, 5, 9, 16, 32};
+	int config_count = 7;
+	int custom = 0;
+
+	for (int i = 1; i < argc; i++) {
+		if (strcmp(argv[i], "-m") == 0 && i + 1 < argc) {
+			total_moves = atoi(argv[++i]);
+		}
+		else if (strcmp(argv[i], "-t") == 0 && i + 1 < argc) {
+			only = argv[++i];
+		}
+		else if (atoi(argv[i]) > 0 && atoi(argv[i]) <= MAX_BENCH_PLAYERS && custom < MAX_BENCH_PLAYERS) {
+			player_counts[custom++] = atoi(argv[i]);
+			config_count = custom;
+		}
+		else {
+			usage(argv[0]);
+			return EXIT_FAILURE;
+		}
+	}
+	if (total_moves <= 0) {
+		usage(argv[0]);
+		return EXIT_FAILURE;
+	}
+
+	bool known = (only == NULL);
+	for (size_t t = 0; t < sizeof(transports) / sizeof(transports[0]) && !known; t++) {
+		known = strcmp(only, transports[t].name) == 0;
+	}
+	if (!known) {
+		fprintf(stderr, "Error: Unknown transport '%s'\n", only);
+		usage(argv[0]);
+		return EXIT_FAILURE;
+	}
+
+	// Compartida con los jugadores por herencia del fork
+	shared_t *shared = mmap(NULL, sizeof(shared_t), PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+	if (shared == MAP_FAILED) {
+		perror("Error mapping shared memory");
+		return EXIT_FAILURE;
+	}
+
+	printf("transport,players,moves,moves_per_sec,rtt_avg_us,rtt_p50_us,rtt_p90_us,rtt_p99_us,rtt_max_us\n");
+	int failures = 0;
+	for (size_t t = 0; t < sizeof(transports) / sizeof(transports[0]); t++) {
+		if (only != NULL && strcmp(only, transports[t].name) != 0)
+			continue;
+		for (int c = 0; c < config_count; c++) {
+			failures += (run_config(&transports[t], player_counts[c], total_moves, shared) != 0);
+		}
+	}
+
+	munmap(shared, sizeof(shared_t));
+	return failures == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
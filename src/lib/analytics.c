@@ -0,0 +1,258 @@
+// This is a personal academic project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: https://pvs-studio.com
+#define _GNU_SOURCE
+#include "analytics.h"
+#include "common.h"
+#include "engine.h"
+#include "library.h"
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// Estado privado del master para publicar el analisis
+struct analytics {
+	game_analytics_t *shared; // Segmento compartido
+	int fd;					  // Descriptor del segmento
+	size_t size;			  // Tamaño del segmento
+	int *queue;				  // Cola del flood fill
+};
+
+/**
+ * @brief Cota de regiones: con 8 vecinos, dos regiones no pueden tener celdas adyacentes
+ */
+static unsigned int max_regions(int width, int height) {
+	return (unsigned int) (((width + 1) / 2) * ((height + 1) / 2));
+}
+
+size_t calculate_analytics_size(int width, int height) {
+	return sizeof(game_analytics_t) + (size_t) width * height * sizeof(unsigned int) +
+		   (size_t) max_regions(width, height) * sizeof(analytics_region_t);
+}
+
+const analytics_region_t *analytics_regions(const game_analytics_t *analytics) {
+	return (const analytics_region_t *) (analytics->labels + (size_t) analytics->width * analytics->height);
+}
+
+int analytics_create(master_context_t *ctx) {
+	struct analytics *analytics = calloc(1, sizeof(struct analytics));
+	if (analytics == NULL) {
+		perror("Error allocating analytics");
+		return -1;
+	}
+
+	analytics->size = calculate_analytics_size(ctx->config.width, ctx->config.height);
+	analytics->queue = malloc((size_t) ctx->config.width * ctx->config.height * sizeof(int));
+	analytics->fd = shm_open(shm_name(GAME_ANALYTICS_SHM), O_CREAT | O_RDWR | O_EXCL, 0644);
+	if (analytics->queue == NULL || analytics->fd == -1) {
+		perror("Error creating analytics shared memory");
+		free(analytics->queue);
+		free(analytics);
+		return -1;
+	}
+
+	if (ftruncate(analytics->fd, (off_t) analytics->size) == -1) {
+		perror("Error setting analytics size");
+		close(analytics->fd);
+		shm_unlink(shm_name(GAME_ANALYTICS_SHM));
+		free(analytics->queue);
+		free(analytics);
+		return -1;
+	}
+
+	analytics->shared = mmap(NULL, analytics->size, PROT_READ | PROT_WRITE, MAP_SHARED, analytics->fd, 0);
+	if (analytics->shared == MAP_FAILED) {
+		perror("Error mapping analytics");
+		close(analytics->fd);
+		shm_unlink(shm_name(GAME_ANALYTICS_SHM));
+		free(analytics->queue);
+		free(analytics);
+		return -1;
+	}
+
+	analytics->shared->width = (unsigned short) ctx->config.width;
+	analytics->shared->height = (unsigned short) ctx->config.height;
+	analytics->shared->max_regions = max_regions(ctx->config.width, ctx->config.height);
+	ctx->analytics = analytics;
+
+	analytics_update(ctx);
+	return 0;
+}
+
+/**
+ * @brief Etiqueta una region con un flood fill desde una celda libre
+ */
+static void label_region(struct analytics *analytics, const game_state_t *state, int start, unsigned int label,
+						 analytics_region_t *region) {
+	game_analytics_t *shared = analytics->shared;
+	int head = 0, tail = 0;
+
+	shared->labels[start] = label;
+	analytics->queue[tail++] = start;
+	region->cells = 0;
+	region->reward = 0;
+	region->player_mask = 0;
+
+	while (head < tail) {
+		int cell = analytics->queue[head++];
+		region->cells++;
+		region->reward += (unsigned int) state->board[cell];
+
+		int x = cell % state->width;
+		int y = cell / state->width;
+		for (int dir = 0; dir < ENGINE_DIRECTIONS; dir++) {
+			int nx, ny;
+			if (!engine_target(state->board, state->width, state->height, x, y, (direction_t) dir, &nx, &ny))
+				continue;
+			int next = ny * state->width + nx;
+			if (shared->labels[next] == 0) {
+				shared->labels[next] = label;
+				analytics->queue[tail++] = next;
+			}
+		}
+	}
+}
+
+void analytics_update(master_context_t *ctx) {
+	struct analytics *analytics = ctx->analytics;
+	if (analytics == NULL)
+		return;
+
+	const game_state_t *state = ctx->game_state;
+	game_analytics_t *shared = analytics->shared;
+	analytics_region_t *regions = (analytics_region_t *) analytics_regions(shared);
+	analytics_summary_t *summary = &shared->summary;
+	int cells = state->width * state->height;
+
+	// Secuencia impar: los lectores descartan lo que copien mientras tanto
+	shared->sequence++;
+	__sync_synchronize();
+
+	memset(shared->labels, 0, (size_t) cells * sizeof(unsigned int));
+	unsigned int tick = summary->tick;
+	memset(summary, 0, sizeof(*summary));
+	summary->tick = tick + 1;
+
+	for (int cell = 0; cell < cells; cell++) {
+		if (state->board[cell] <= 0 || shared->labels[cell] != 0)
+			continue;
+		analytics_region_t *region = &regions[summary->region_count];
+		label_region(analytics, state, cell, ++summary->region_count, region);
+		summary->free_cells += region->cells;
+		summary->free_reward += region->reward;
+		if (region->cells > summary->largest_region) {
+			summary->largest_region = region->cells;
+		}
+	}
+
+	// Area alcanzable: suma de las regiones distintas que rodean a cada jugador
+	for (unsigned int i = 0; i < state->player_count; i++) {
+		unsigned int seen[ENGINE_DIRECTIONS];
+		int seen_count = 0;
+		for (int dir = 0; dir < ENGINE_DIRECTIONS; dir++) {
+			int nx, ny;
+			if (!engine_target(state->board, state->width, state->height, state->players[i].x, state->players[i].y,
+							   (direction_t) dir, &nx, &ny))
+				continue;
+			unsigned int label = shared->labels[ny * state->width + nx];
+			bool repeated = false;
+			for (int j = 0; j < seen_count; j++) {
+				repeated = repeated || seen[j] == label;
+			}
+			if (repeated)
+				continue;
+			seen[seen_count++] = label;
+			regions[label - 1].player_mask |= (unsigned short) (1u << i);
+			summary->reachable_cells[i] += regions[label - 1].cells;
+			summary->reachable_reward[i] += regions[label - 1].reward;
+		}
+	}
+
+	__sync_synchronize();
+	shared->sequence++;
+}
+
+void analytics_destroy(master_context_t *ctx) {
+	struct analytics *analytics = ctx->analytics;
+	if (analytics == NULL)
+		return;
+
+	munmap(analytics->shared, analytics->size);
+	close(analytics->fd);
+	shm_unlink(shm_name(GAME_ANALYTICS_SHM));
+	free(analytics->queue);
+	free(analytics);
+	ctx->analytics = NULL;
+}
+
+const game_analytics_t *analytics_connect(int width, int height, int *fd) {
+	*fd = shm_open(shm_name(GAME_ANALYTICS_SHM), O_RDONLY, 0);
+	if (*fd == -1)
+		return NULL;
+
+	// Un segmento que quedo de otra partida puede ser mas chico: mapearlo daria SIGBUS al leer
+	struct stat shm_stat;
+	if (fstat(*fd, &shm_stat) == -1 || (size_t) shm_stat.st_size < calculate_analytics_size(width, height)) {
+		close(*fd);
+		*fd = -1;
+		return NULL;
+	}
+
+	const game_analytics_t *analytics =
+		mmap(NULL, calculate_analytics_size(width, height), PROT_READ, MAP_SHARED, *fd, 0);
+	if (analytics == MAP_FAILED) {
+		close(*fd);
+		*fd = -1;
+		return NULL;
+	}
+	return analytics;
+}
+
+void analytics_disconnect(const game_analytics_t **analytics, int *fd) {
+	if (*analytics != NULL) {
+		munmap((void *) *analytics, calculate_analytics_size((*analytics)->width, (*analytics)->height));
+		*analytics = NULL;
+	}
+	if (*fd != -1) {
+		close(*fd);
+		*fd = -1;
+	}
+}
+
+void analytics_read_summary(const game_analytics_t *analytics, analytics_summary_t *summary) {
+	unsigned int before, after;
+	do {
+		before = analytics->sequence;
+		__sync_synchronize();
+		memcpy(summary, &analytics->summary, sizeof(*summary));
+		__sync_synchronize();
+		after = analytics->sequence;
+	} while ((before & 1) != 0 || before != after);
+}
+
+unsigned int analytics_read_regions(const game_analytics_t *analytics, const int *cells, int count,
+									analytics_region_t *regions) {
+	const analytics_region_t *shared = analytics_regions(analytics);
+	unsigned int before, after, tick;
+	do {
+		before = analytics->sequence;
+		__sync_synchronize();
+		tick = analytics->summary.tick;
+		for (int i = 0; i < count; i++) {
+			// Durante una escritura la etiqueta puede ser de otro tick: se acota y la copia se descarta al reintentar
+			unsigned int label = analytics->labels[cells[i]];
+			if (label == 0 || label > analytics->max_regions) {
+				memset(&regions[i], 0, sizeof(regions[i]));
+			}
+			else {
+				regions[i] = shared[label - 1];
+			}
+		}
+		__sync_synchronize();
+		after = analytics->sequence;
+	} while ((before & 1) != 0 || before != after);
+	return tick;
+}
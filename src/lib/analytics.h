@@ -0,0 +1,114 @@
+#ifndef ANALYTICS_H
+#define ANALYTICS_H
+
+#include "common.h"
+
+/*
+ * Analisis del tablero publicado por el master (--analytics).
+ *
+ * Despues de cada movimiento procesado (un tick) el master etiqueta las regiones conexas de celdas libres y publica
+ * en el segmento de solo lectura GAME_ANALYTICS_SHM la region de cada celda, el tamaño y la recompensa de cada
+ * region y el area alcanzable por cada jugador. Asi los jugadores y la vista no repiten el mismo flood fill.
+ *
+ * El master es el unico escritor y no toma semaforos: publica con un contador de secuencia (seqlock) que queda
+ * impar mientras escribe. Los lectores copian lo que necesitan y reintentan si la secuencia cambio.
+ */
+
+// Region conexa (8 vecinos) de celdas libres
+typedef struct {
+	unsigned int cells;			// Cantidad de celdas
+	unsigned int reward;		// Suma de recompensas
+	unsigned short player_mask;	// Jugadores adyacentes a la region (bit i = jugador i)
+} analytics_region_t;
+
+// Resumen de un tick
+typedef struct {
+	unsigned int tick;							// Movimientos procesados por el master
+	unsigned int region_count;					// Cantidad de regiones libres
+	unsigned int free_cells;					// Celdas libres en todo el tablero
+	unsigned int free_reward;					// Recompensa libre en todo el tablero
+	unsigned int largest_region;				// Celdas de la region mas grande
+	unsigned int reachable_cells[MAX_PLAYERS];	// Celdas de las regiones adyacentes a cada jugador
+	unsigned int reachable_reward[MAX_PLAYERS];	// Recompensa de esas regiones
+} analytics_summary_t;
+
+// Segmento compartido: encabezado, etiqueta por celda y luego las regiones
+typedef struct game_analytics {
+	volatile unsigned int sequence;	// Impar mientras el master escribe
+	unsigned short width;			// Ancho del tablero
+	unsigned short height;			// Alto del tablero
+	unsigned int max_regions;		// Capacidad del arreglo de regiones
+	analytics_summary_t summary;	// Resumen del ultimo tick
+	unsigned int labels[];			// Region de cada celda (1..region_count, 0 si esta ocupada)
+} game_analytics_t;
+
+/**
+ * @brief Calcula el tamaño del segmento de analisis
+ * @param width Ancho del tablero
+ * @param height Alto del tablero
+ * @return Tamaño en bytes
+ */
+size_t calculate_analytics_size(int width, int height);
+
+/**
+ * @brief Devuelve el arreglo de regiones (indice = etiqueta - 1)
+ */
+const analytics_region_t *analytics_regions(const game_analytics_t *analytics);
+
+/**
+ * @brief Crea el segmento de analisis y publica el tick inicial
+ * @param ctx Puntero al contexto del master (con el estado ya inicializado)
+ * @return 0 si la creacion fue exitosa, -1 en caso de error
+ */
+int analytics_create(master_context_t *ctx);
+
+/**
+ * @brief Recalcula y publica el analisis del tablero (no hace nada si --analytics no esta activo)
+ * @param ctx Puntero al contexto del master
+ */
+void analytics_update(master_context_t *ctx);
+
+/**
+ * @brief Desmapea y elimina el segmento de analisis
+ * @param ctx Puntero al contexto del master
+ */
+void analytics_destroy(master_context_t *ctx);
+
+/**
+ * @brief Mapea el segmento de analisis como solo lectura
+ * @param width Ancho del tablero
+ * @param height Alto del tablero
+ * @param fd Puntero para almacenar el descriptor
+ * @return Puntero al segmento, o NULL si el master no lo publica (o es de otro tamaño de tablero)
+ */
+const game_analytics_t *analytics_connect(int width, int height, int *fd);
+
+/**
+ * @brief Desmapea el segmento de analisis de un lector
+ * @param analytics Puntero al segmento (se pone en NULL)
+ * @param fd Puntero al descriptor (se pone en -1)
+ */
+void analytics_disconnect(const game_analytics_t **analytics, int *fd);
+
+/**
+ * @brief Copia un resumen consistente del ultimo tick
+ * @param analytics Segmento de analisis
+ * @param summary Resumen a llenar
+ */
+void analytics_read_summary(const game_analytics_t *analytics, analytics_summary_t *summary);
+
+/**
+ * @brief Copia de forma consistente la region de cada celda pedida
+ * @param analytics Segmento de analisis
+ * @param cells Indices de las celdas (y * width + x)
+ * @param count Cantidad de celdas
+ * @param regions Region de cada celda; queda en cero si la celda esta ocupada en ese tick
+ * @return Tick al que corresponden las regiones copiadas
+ * @details Todas las regiones salen del mismo tick, asi que dos celdas de la misma region reciben los mismos datos.
+ * El master publica despues de dar el turno, asi que el tick puede ir un movimiento detras del estado que ve el
+ * jugador: quien llama debe validar las celdas contra su copia del tablero.
+ */
+unsigned int analytics_read_regions(const game_analytics_t *analytics, const int *cells, int count,
+									analytics_region_t *regions);
+
+#endif // ANALYTICS_H
@@ -1,14 +1,20 @@
 #ifndef COMMON_H
 #define COMMON_H
 
+#include "histogram.h"
+#include "spin_wait.h"
 #include <semaphore.h>
 #include <stdbool.h>
+#include <stdio.h>
+#include <sys/resource.h>
 #include <sys/types.h>
+#include <time.h>
 
 #define MAX_PLAYERS 9
 #define MAX_NAME_LEN 16
 #define GAME_STATE_SHM "/game_state"
 #define GAME_SYNC_SHM "/game_sync"
+#define GAME_ANALYTICS_SHM "/game_analytics"
 
 #define VIEW_TIMEOUT_SEC 2
 #define VIEW_CLEANUP_TIMEOUT_SEC 1
@@ -20,7 +26,12 @@
 #define CLEANUP_SLEEP_MS 100
 #define FINAL_SYNC_SLEEP_MS 500
 #define INIT_SYNC_SLEEP_MS 100
-#define START_SLEEP_SEC 3
+#define START_SLEEP_SEC 3									   // Espera maxima de players_ready (y pausa con vista)
+#define REAP_GRACE_MS 500									   // Plazo para que los hijos terminen solos
+#define REAP_TERM_MS (MAX_CLEANUP_ATTEMPTS * CLEANUP_SLEEP_MS) // Plazo entre SIGTERM y SIGKILL
+#define PLAYER_ID_ENV "CHOMP_PLAYER_ID"						   // Indice del jugador pasado por el master a cada hijo
+#define TIMEOUT_ENV "CHOMP_TIMEOUT_SEC"						   // Timeout del master exportado a los jugadores
+#define SHM_NAMESPACE_ENV "CHOMP_SHM_NAMESPACE"				   // Sufijo de los segmentos compartidos (shm_name)
 
 // Direcciones de movimiento
 typedef enum {
@@ -64,6 +75,7 @@ typedef struct {
 	sem_t reader_count_mutex;		// Mutex para reader_count (E)
 	unsigned int reader_count;		// Cantidad de jugadores leyendo estado (F)
 	sem_t player_turn[MAX_PLAYERS]; // Semaforos para cada jugador (G)
+	sem_t players_ready;			// Cada jugador avisa que cargo su estrategia (H, al final por compatibilidad)
 } game_sync_t;
 
 // Configuracion del master
@@ -74,39 +86,115 @@ typedef struct {
 	int timeout;		 // Tiempo de espera para la vista
 	unsigned int seed;	 // Semilla para la generacion de numeros aleatorios
 	char *view_path;	 // Ruta de la vista
+	char *record_path;	 // Ruta del archivo de grabacion de la partida
 	char **player_paths; // Rutas de los ejecutables de los jugadores
 	int player_count;	 // Cantidad de jugadores
+	bool threads;		 // Ejecutar los jugadores como threads del master (--threads)
+	bool analytics;		 // Publicar el analisis del tablero en cada tick (--analytics)
+	int spin_us;		 // Spin antes de bloquear en los semaforos (--spin, -1: automatico)
+	char *pin;			 // Ubicacion de los procesos en las CPUs (--pin, ver placement.h)
+	char *sched;		 // Clase de planificacion (--sched, ver placement.h)
+	char *usage_path;	 // Archivo CSV con el uso de recursos de cada proceso (--usage)
+	bool latency;		 // Imprimir los histogramas de latencia por turno (--latency)
+	bool lock_stats;	 // Instrumentar los locks del estado (--lock-stats)
+	bool live_stats;	 // Publicar estadisticas en vivo para chompstat (--live-stats)
+	char *trace_path;	 // Archivo Chrome trace con las fases de todos los procesos (--trace)
+	bool syscalls;		 // Contar las llamadas al sistema por movimiento (--syscalls)
+	bool rounds;		 // Turnos simultaneos: se aplica un movimiento de cada jugador por ronda (--rounds)
 } master_config_t;
 
+// Estado del modo con threads (definido en thread_mode.c)
+struct thread_mode;
+
+// Estado privado del analisis publicado por el master (definido en analytics.c)
+struct analytics;
+
+// Segmento de analisis de solo lectura (definido en analytics.h)
+struct game_analytics;
+
+// Estadisticas de los locks y lugar de cada proceso (definidos en lock_stats.h)
+struct game_lock_stats;
+struct lock_slot;
+
+// Estadisticas en vivo (definidas en live_stats.h)
+struct game_live_stats;
+
+// Anillos de trazas de cada proceso (definidos en trace.h)
+struct game_trace;
+struct trace_ring;
+
+// Contadores de llamadas al sistema (definidos en syscall_stats.h)
+struct game_syscalls;
+
 // Contexto del master - variables globales
 typedef struct {
-	game_state_t *game_state; // Estado del juego
-	game_sync_t *game_sync;	  // Estructura de sincronizacion
-	int state_fd;			  // Descriptor de memoria compartida del estado
-	int sync_fd;			  // Descriptor de memoria compartida de sincronizacion
-	pid_t *player_pids;		  // Array de PIDs de jugadores
-	pid_t view_pid;			  // PID del proceso de vista
-	int *player_pipes;		  // Array de pipes para comunicacion con jugadores
-	master_config_t config;	  // Configuracion del master
-	bool cleanup_done;		  // Flag de limpieza completada
-	bool view_active;		  // Flag de vista activa
+	game_state_t *game_state;						 // Estado del juego
+	game_sync_t *game_sync;							 // Estructura de sincronizacion
+	int state_fd;									 // Descriptor de memoria compartida del estado
+	int sync_fd;									 // Descriptor de memoria compartida de sincronizacion
+	pid_t *player_pids;								 // Array de PIDs de jugadores
+	pid_t view_pid;									 // PID del proceso de vista
+	int *player_pipes;								 // Array de pipes para comunicacion con jugadores
+	master_config_t config;							 // Configuracion del master
+	bool cleanup_done;								 // Flag de limpieza completada
+	bool view_active;								 // Flag de vista activa
+	FILE *record_file;								 // Archivo de grabacion de la partida (NULL si no se graba)
+	struct thread_mode *threads;					 // Jugadores en threads (NULL en el modo con procesos)
+	struct analytics *analytics;					 // Analisis publicado (NULL sin --analytics)
+	wait_stats_t view_done_wait;					 // Esperas de view_done
+	int player_status[MAX_PLAYERS];					 // Estado de waitpid de cada jugador (valido si player_reaped)
+	bool player_reaped[MAX_PLAYERS];				 // Si el jugador ya fue recogido
+	int view_status;								 // Estado de waitpid de la vista (valido si view_reaped)
+	bool view_reaped;								 // Si la vista ya fue recogida
+	struct timespec start_time;						 // Momento en que se empezaron a crear los jugadores
+	double ready_ms;								 // Desde start_time hasta que todos avisaron players_ready
+	double first_move_ms;							 // Hasta el primer movimiento (0: todavia no hubo)
+	double last_move_ms;							 // Hasta el ultimo movimiento procesado
+	struct rusage player_usage[MAX_PLAYERS];		 // Recursos de cada jugador (wait4 o RUSAGE_THREAD)
+	bool player_measured[MAX_PLAYERS];				 // Si player_usage tiene datos
+	struct rusage view_usage;						 // Recursos de la vista (valido si view_reaped)
+	unsigned long long turn_granted_ns[MAX_PLAYERS]; // Momento en que se dio el turno a cada jugador
+	histogram_t turn_latency[MAX_PLAYERS];			 // Desde el turno hasta que se toma el movimiento (por jugador)
+	histogram_t apply_latency;						 // Validar y aplicar (incluye esperar el lock)
+	histogram_t view_latency;						 // Desde view_ready hasta view_done
+	struct game_lock_stats *lock_stats;				 // Estadisticas de los locks (NULL sin --lock-stats)
+	struct game_live_stats *live_stats;				 // Estadisticas en vivo (NULL sin --live-stats)
+	struct game_trace *trace;						 // Anillos de trazas (NULL sin --trace)
+	struct trace_ring *trace_ring;					 // Anillo del master
+	struct game_syscalls *syscalls;					 // Contadores de llamadas (NULL sin --syscalls)
+	unsigned int placed;							 // Procesos a los que se aplico --pin/--sched
+	unsigned int placement_failures;				 // De esos, en cuantos fallo algo
 } master_context_t;
 
 // Contexto del view - variables globales
 typedef struct {
-	game_state_t *game_state; // Estado del juego
-	game_sync_t *game_sync;	  // Estructura de sincronizacion
-	int state_fd;			  // Descriptor de memoria compartida del estado
-	int sync_fd;			  // Descriptor de memoria compartida de sincronizacion
+	game_state_t *game_state;				// Estado del juego
+	game_sync_t *game_sync;					// Estructura de sincronizacion
+	int state_fd;							// Descriptor de memoria compartida del estado
+	int sync_fd;							// Descriptor de memoria compartida de sincronizacion
+	const struct game_analytics *analytics; // Analisis publicado por el master (NULL si no hay)
+	int analytics_fd;						// Descriptor del segmento de analisis
+	wait_stats_t view_ready_wait;			// Esperas de view_ready
+	struct trace_ring *trace_ring;			// Anillo de trazas de la vista (NULL sin --trace)
 } view_context_t;
 
+// Envio de un movimiento al master (pipe en el modo con procesos, buzon en el modo con threads)
+typedef void (*move_sender_t)(void *arg, direction_t move);
+
 // Contexto del player - variables globales
 typedef struct {
-	game_state_t *game_state; // Estado del juego
-	game_sync_t *game_sync;	  // Estructura de sincronizacion
-	int state_fd;			  // Descriptor de memoria compartida del estado
-	int sync_fd;			  // Descriptor de memoria compartida de sincronizacion
-	int player_id;			  // ID del jugador
+	game_state_t *game_state;	   // Estado del juego
+	game_sync_t *game_sync;		   // Estructura de sincronizacion
+	int state_fd;				   // Descriptor de memoria compartida del estado
+	int sync_fd;				   // Descriptor de memoria compartida de sincronizacion
+	int player_id;				   // ID del jugador
+	move_sender_t send_move_fn;	   // Envio alternativo del movimiento (NULL: pipe por stdout)
+	void *send_move_arg;		   // Argumento de send_move_fn
+	wait_stats_t turn_wait;		   // Esperas de player_turn
+	struct lock_slot *lock_slot;   // Lugar del jugador en las estadisticas de locks (NULL si no hay)
+	struct trace_ring *trace_ring; // Anillo de trazas del jugador (NULL sin --trace)
+	const struct game_analytics *analytics; // Analisis publicado por el master (NULL sin --analytics)
+	int analytics_fd;						// Descriptor del segmento de analisis
 } player_context_t;
 
 #endif // COMMON_H
\ No newline at end of file
@@ -4,6 +4,11 @@
 #include "config_management.h"
 #include "common.h"
 #include "library.h"
+#include "live_stats.h"
+#include "lock_stats.h"
+#include "placement.h"
+#include "process_management.h"
+#include "syscall_stats.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -20,8 +25,21 @@ void parse_arguments(int argc, char *argv[], master_config_t *config) {
 	config->timeout = DEFAULT_TIMEOUT_SEC;
 	config->seed = time(NULL);
 	config->view_path = NULL;
+	config->record_path = NULL;
 	config->player_paths = NULL;
 	config->player_count = 0;
+	config->threads = false;
+	config->analytics = false;
+	config->spin_us = -1;
+	config->pin = NULL;
+	config->sched = NULL;
+	config->usage_path = NULL;
+	config->latency = false;
+	config->lock_stats = false;
+	config->live_stats = false;
+	config->trace_path = NULL;
+	config->syscalls = false;
+	config->rounds = false;
 
 	int i = 1;
 	while (i < argc) {
@@ -43,6 +61,45 @@ void parse_arguments(int argc, char *argv[], master_config_t *config) {
 		else if (strcmp(argv[i], "-v") == 0 && i + 1 < argc) {
 			config->view_path = argv[++i];
 		}
+		else if (strcmp(argv[i], "-r") == 0 && i + 1 < argc) {
+			config->record_path = argv[++i];
+		}
+		else if (strcmp(argv[i], "--threads") == 0) {
+			config->threads = true;
+		}
+		else if (strcmp(argv[i], "--analytics") == 0) {
+			config->analytics = true;
+		}
+		else if (strcmp(argv[i], "--spin") == 0 && i + 1 < argc) {
+			config->spin_us = atoi(argv[++i]);
+		}
+		else if (strcmp(argv[i], "--pin") == 0 && i + 1 < argc) {
+			config->pin = argv[++i];
+		}
+		else if (strcmp(argv[i], "--sched") == 0 && i + 1 < argc) {
+			config->sched = argv[++i];
+		}
+		else if (strcmp(argv[i], "--usage") == 0 && i + 1 < argc) {
+			config->usage_path = argv[++i];
+		}
+		else if (strcmp(argv[i], "--latency") == 0) {
+			config->latency = true;
+		}
+		else if (strcmp(argv[i], "--lock-stats") == 0) {
+			config->lock_stats = true;
+		}
+		else if (strcmp(argv[i], "--live-stats") == 0) {
+			config->live_stats = true;
+		}
+		else if (strcmp(argv[i], "--trace") == 0 && i + 1 < argc) {
+			config->trace_path = argv[++i];
+		}
+		else if (strcmp(argv[i], "--syscalls") == 0) {
+			config->syscalls = true;
+		}
+		else if (strcmp(argv[i], "--rounds") == 0) {
+			config->rounds = true;
+		}
 		else if (strcmp(argv[i], "-p") == 0) {
 			int j = i + 1;
 			while (j < argc && argv[j][0] != '-') {
@@ -91,6 +148,17 @@ void parse_arguments(int argc, char *argv[], master_config_t *config) {
 		fprintf(stderr, "Error: Invalid number of players (1-%d allowed)\n", MAX_PLAYERS);
 		exit(EXIT_FAILURE);
 	}
+	if (config->spin_us > SPIN_MAX_US) {
+		fprintf(stderr, "Error: Spin must be at most %d us\n", SPIN_MAX_US);
+		exit(EXIT_FAILURE);
+	}
+	if (!placement_valid(config)) {
+		exit(EXIT_FAILURE);
+	}
+	if (config->threads && config->view_path != NULL) {
+		fprintf(stderr, "Error: The view is not supported with --threads\n");
+		exit(EXIT_FAILURE);
+	}
 }
 
 void print_final_results(master_context_t *ctx) {
@@ -122,19 +190,10 @@ void print_final_results(master_context_t *ctx) {
 	for (int i = 0; i < ctx->config.player_count; i++) {
 		int idx = sorted_indices[i];
 
-		// Estado de salida del procesos
+		// Estado de salida del proceso (recogido por reap_children al terminar la partida)
 		int exit_status = 0;
-		if (ctx->player_pids[idx] > 0) {
-			int status;
-			pid_t result = waitpid(ctx->player_pids[idx], &status, WNOHANG);
-			if (result > 0) {
-				if (WIFEXITED(status)) {
-					exit_status = WEXITSTATUS(status);
-				}
-				else if (WIFSIGNALED(status)) {
-					exit_status = WTERMSIG(status);
-				}
-			}
+		if (ctx->player_reaped[idx]) {
+			exit_status = child_exit_code(ctx->player_status[idx]);
 		}
 
 		printf("%d. %s (%sP%d\033[0m) (%d): %u points (%u V, %u I)\n", i + 1, ctx->game_state->players[idx].name,
@@ -145,6 +204,57 @@ void print_final_results(master_context_t *ctx) {
 	printf("=====================\n");
 }
 
+static double timeval_ms(struct timeval time) {
+	return time.tv_sec * 1000.0 + time.tv_usec / 1000.0;
+}
+
+static void print_usage_row(FILE *out, bool csv, const char *name, const struct rusage *usage) {
+	const char *format = csv ? "%s,%.3f,%.3f,%ld,%ld,%ld,%ld,%ld\n" : "%-8s %10.1f %10.1f %8ld %8ld %8ld %8ld %10ld\n";
+	fprintf(out, format, name, timeval_ms(usage->ru_utime), timeval_ms(usage->ru_stime), usage->ru_nvcsw,
+			usage->ru_nivcsw, usage->ru_majflt, usage->ru_minflt, usage->ru_maxrss);
+}
+
+/**
+ * @brief Escribe una fila por proceso (master, jugadores con datos y vista)
+ */
+static void print_usage_rows(FILE *out, bool csv, master_context_t *ctx, const struct rusage *master) {
+	print_usage_row(out, csv, "master", master);
+	for (int i = 0; i < ctx->config.player_count; i++) {
+		if (ctx->player_reaped[i] || ctx->player_measured[i]) {
+			char name[16];
+			snprintf(name, sizeof(name), "P%d", i + 1);
+			print_usage_row(out, csv, name, &ctx->player_usage[i]);
+		}
+	}
+	if (ctx->view_reaped) {
+		print_usage_row(out, csv, "view", &ctx->view_usage);
+	}
+}
+
+void print_resource_usage(master_context_t *ctx) {
+	// Solo el thread principal: con --threads los jugadores se miden por separado
+	struct rusage master;
+	getrusage(RUSAGE_THREAD, &master);
+
+	printf("\n=== RESOURCE USAGE ===\n");
+	printf("%-8s %10s %10s %8s %8s %8s %8s %10s\n", "Process", "User ms", "Sys ms", "Vol CS", "Invol CS", "Maj flt",
+		   "Min flt", "Max RSS KB");
+	print_usage_rows(stdout, false, ctx, &master);
+	printf("======================\n");
+
+	if (ctx->config.usage_path == NULL)
+		return;
+
+	FILE *file = fopen(ctx->config.usage_path, "w");
+	if (file == NULL) {
+		perror("Error opening usage file");
+		return;
+	}
+	fprintf(file, "process,user_ms,sys_ms,voluntary_cs,involuntary_cs,major_faults,minor_faults,max_rss_kb\n");
+	print_usage_rows(file, true, ctx, &master);
+	fclose(file);
+}
+
 void display_game_parameters(const master_config_t *config) {
 	printf("\n");
 	printf("========================================\n");
@@ -155,12 +265,53 @@ void display_game_parameters(const master_config_t *config) {
 	printf("Timeout: %ds\n", config->timeout);
 	printf("Seed: %u\n", config->seed);
 	printf("Players: %d\n", config->player_count);
+	if (config->threads) {
+		printf("Mode: threads\n");
+	}
+	if (config->record_path != NULL) {
+		printf("Record: %s\n", config->record_path);
+	}
+	if (config->analytics) {
+		printf("Analytics: %s\n", shm_name(GAME_ANALYTICS_SHM));
+	}
+	if (config->spin_us >= 0) {
+		printf("Spin: %dus\n", config->spin_us);
+	}
+	if (config->pin != NULL) {
+		printf("Pin: %s\n", config->pin);
+	}
+	if (config->sched != NULL) {
+		printf("Sched: %s\n", config->sched);
+	}
+	if (config->usage_path != NULL) {
+		printf("Usage: %s\n", config->usage_path);
+	}
+	if (config->lock_stats) {
+		printf("Lock stats: %s\n", config->threads ? "private" : shm_name(LOCK_STATS_SHM));
+	}
+	if (config->live_stats) {
+		printf("Live stats: %s\n", shm_name(GAME_LIVE_STATS_SHM));
+	}
+	if (config->trace_path != NULL) {
+		printf("Trace: %s\n", config->trace_path);
+	}
+	if (config->syscalls) {
+		printf("Syscalls: %s\n", config->threads ? "private" : shm_name(GAME_SYSCALLS_SHM));
+	}
+	if (config->rounds) {
+		printf("Rounds: simultaneous turns\n");
+	}
 }
 
 void display_processes_info(const master_config_t *config, const pid_t *player_pids, pid_t view_pid, bool view_active) {
 	// Informacion de procesos creados
 	for (int i = 0; i < config->player_count; i++) {
-		printf("   %d. %s (PID: %d)\n", i + 1, config->player_paths[i], player_pids[i]);
+		if (player_pids != NULL) {
+			printf("   %d. %s (PID: %d)\n", i + 1, config->player_paths[i], player_pids[i]);
+		}
+		else {
+			printf("   %d. %s (thread)\n", i + 1, config->player_paths[i]);
+		}
 	}
 
 	if (view_active && config->view_path) {
@@ -175,6 +326,4 @@ void display_game_start(void) {
 	printf("========================================\n");
 	printf("            STARTING GAME...\n");
 	printf("========================================\n\n");
-
-	usleep(START_SLEEP_SEC * 1000000); // para que el usuario pueda leer la informacion
 }
@@ -17,6 +17,14 @@ void parse_arguments(int argc, char *argv[], master_config_t *config);
  */
 void print_final_results(master_context_t *ctx);
 
+/**
+ * @brief Imprime los recursos consumidos por el master, cada jugador y la vista
+ * @param ctx Puntero al contexto del master (con los hijos ya recogidos)
+ * @details CPU de usuario y sistema, cambios de contexto voluntarios e involuntarios, fallos de pagina mayores y
+ * menores y RSS maximo. Si se uso --usage tambien los escribe en ese archivo como CSV.
+ */
+void print_resource_usage(master_context_t *ctx);
+
 /**
  * @brief Muestra los parametros de configuracion del juego
  * @param config Configuracion del juego
@@ -0,0 +1,384 @@
+// This is a personal academic project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: https://pvs-studio.com
+#define _GNU_SOURCE
+#include "endgame.h"
+#include "common.h"
+#include "engine.h"
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#define ENDGAME_INFINITY (ENGINE_MAX_REWARD * ENDGAME_MAX_CELLS + 1)
+
+// Tipo de valor guardado en la tabla
+#define BOUND_EXACT 1
+#define BOUND_LOWER 2
+#define BOUND_UPPER 3
+
+// Sales para que las claves de celdas, posiciones y turno no se mezclen
+#define SALT_CELL 0x243F6A8885A308D3ULL
+#define SALT_POSITION 0x13198A2E03707344ULL
+#define SALT_SIDE 0xA4093822299F31D0ULL
+#define SALT_BOARD 0x082EFA98EC4E6C89ULL
+
+/**
+ * @brief Finalizador de splitmix64: convierte un indice en una clave de Zobrist
+ */
+static uint64_t mix64(uint64_t x) {
+	x ^= x >> 30;
+	x *= 0xBF58476D1CE4E5B9ULL;
+	x ^= x >> 27;
+	x *= 0x94D049BB133111EBULL;
+	x ^= x >> 31;
+	return x;
+}
+
+/*
+ * Las celdas se identifican por su indice lineal, que se repite entre tableros de distinto tamaño (con la misma
+ * semilla un 10x20 y un 20x10 tienen las mismas recompensas en los mismos indices). Como la tabla se comparte entre
+ * partidas, las claves de celdas y posiciones se mezclan con la clave del tablero (ancho y alto).
+ */
+static uint64_t cell_key(const endgame_t *endgame, int cell, int reward) {
+	return mix64((((uint64_t) cell << 4) | (uint64_t) reward) ^ SALT_CELL ^ endgame->board_key);
+}
+
+static uint64_t position_key(const endgame_t *endgame, int player_id, int cell) {
+	return mix64((((uint64_t) cell << 4) | (uint64_t) player_id) ^ SALT_POSITION ^ endgame->board_key);
+}
+
+static uint64_t side_key(int player_id) {
+	return mix64((uint64_t) player_id ^ SALT_SIDE);
+}
+
+/**
+ * @brief Abre (o crea) la tabla de transposicion compartida
+ * @return Puntero a la tabla, o NULL si no se pudo
+ */
+static endgame_entry_t *open_shared_table(size_t size) {
+	int fd = shm_open(ENDGAME_TT_SHM, O_CREAT | O_RDWR, 0600);
+	if (fd == -1)
+		return NULL;
+
+	// Si dos procesos la crean a la vez, ambos la agrandan al mismo tamaño
+	struct stat st;
+	if (fstat(fd, &st) == -1 || ((size_t) st.st_size < size && ftruncate(fd, (off_t) size) == -1)) {
+		close(fd);
+		return NULL;
+	}
+
+	void *table = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+	close(fd);
+	return (table == MAP_FAILED) ? NULL : table;
+}
+
+int endgame_create(endgame_t *endgame, int width, int height) {
+	memset(endgame, 0, sizeof(*endgame));
+	endgame->width = width;
+	endgame->height = height;
+	endgame->board_key = mix64((((uint64_t) width << 32) | (uint64_t) height) ^ SALT_BOARD);
+	endgame->entries = (size_t) 1 << ENDGAME_TT_BITS;
+
+	size_t cells = (size_t) width * height;
+	endgame->mark = calloc(cells, sizeof(unsigned int));
+	endgame->queue = malloc(cells * sizeof(int));
+	if (endgame->mark == NULL || endgame->queue == NULL) {
+		endgame_destroy(endgame);
+		return -1;
+	}
+
+	size_t size = endgame->entries * sizeof(endgame_entry_t);
+	const char *mode = getenv(ENDGAME_TT_ENV);
+	if (mode == NULL || strcmp(mode, "private") != 0) {
+		endgame->table = open_shared_table(size);
+		endgame->shared = endgame->table != NULL;
+	}
+	if (endgame->table == NULL) {
+		endgame->table = calloc(endgame->entries, sizeof(endgame_entry_t));
+	}
+	if (endgame->table == NULL) {
+		endgame_destroy(endgame);
+		return -1;
+	}
+
+	return 0;
+}
+
+void endgame_unlink_shared(void) {
+	const char *mode = getenv(ENDGAME_TT_ENV);
+	if (mode != NULL && strcmp(mode, "drop") == 0) {
+		shm_unlink(ENDGAME_TT_SHM);
+	}
+}
+
+void endgame_destroy(endgame_t *endgame) {
+	if (endgame->table != NULL) {
+		if (endgame->shared) {
+			munmap((void *) endgame->table, endgame->entries * sizeof(endgame_entry_t));
+		}
+		else {
+			free((void *) endgame->table);
+		}
+	}
+	free(endgame->mark);
+	free(endgame->queue);
+	memset(endgame, 0, sizeof(*endgame));
+}
+
+/**
+ * @brief Agrega a la region las celdas libres alcanzables desde la posicion de un jugador
+ * @return Cantidad de celdas en la region, o -1 si supera ENDGAME_MAX_CELLS
+ */
+static int flood_from(endgame_t *endgame, const engine_state_t *state, int player_id, int count) {
+	// Las celdas que ya estaban en la region fueron expandidas por llamadas anteriores
+	int head = count;
+	int x = state->players[player_id].x;
+	int y = state->players[player_id].y;
+
+	for (;;) {
+		for (int dir = 0; dir < ENGINE_DIRECTIONS; dir++) {
+			int nx, ny;
+			if (!engine_target(state->board, endgame->width, endgame->height, x, y, (direction_t) dir, &nx, &ny))
+				continue;
+			int cell = ny * endgame->width + nx;
+			if (endgame->mark[cell] == endgame->stamp)
+				continue;
+			if (count >= ENDGAME_MAX_CELLS)
+				return -1;
+			endgame->mark[cell] = endgame->stamp;
+			endgame->queue[count++] = cell;
+		}
+		if (head >= count)
+			break;
+		x = endgame->queue[head] % endgame->width;
+		y = endgame->queue[head] / endgame->width;
+		head++;
+	}
+	return count;
+}
+
+/**
+ * @brief Indica si un jugador toca alguna celda de la region
+ */
+static bool touches_region(const endgame_t *endgame, const engine_state_t *state, int player_id) {
+	for (int dir = 0; dir < ENGINE_DIRECTIONS; dir++) {
+		int nx, ny;
+		if (engine_target(state->board, endgame->width, endgame->height, state->players[player_id].x,
+						  state->players[player_id].y, (direction_t) dir, &nx, &ny) &&
+			endgame->mark[ny * endgame->width + nx] == endgame->stamp) {
+			return true;
+		}
+	}
+	return false;
+}
+
+/**
+ * @brief Calcula la region cerrada del final y los jugadores involucrados
+ * @return Cantidad de celdas de la region, o -1 si no es un final que se pueda resolver
+ */
+static int find_region(endgame_t *endgame, const engine_state_t *state, int player_id) {
+	if (++endgame->stamp == 0) {
+		memset(endgame->mark, 0, (size_t) endgame->width * endgame->height * sizeof(unsigned int));
+		endgame->stamp = 1;
+	}
+
+	endgame->players[0] = player_id;
+	endgame->player_count = 1;
+	int count = flood_from(endgame, state, player_id, 0);
+
+	// Se agregan los rivales que tocan la region hasta que no cambie
+	bool changed = true;
+	while (count >= 0 && changed) {
+		changed = false;
+		for (int rival = 0; rival < (int) state->player_count && count >= 0; rival++) {
+			bool involved = false;
+			for (int i = 0; i < endgame->player_count; i++) {
+				involved = involved || endgame->players[i] == rival;
+			}
+			if (involved || !touches_region(endgame, state, rival))
+				continue;
+			if (endgame->player_count == ENDGAME_MAX_PLAYERS)
+				return -1;
+			endgame->players[endgame->player_count++] = rival;
+			count = flood_from(endgame, state, rival, count);
+			changed = true;
+		}
+	}
+	return count;
+}
+
+static void store(endgame_t *endgame, int value, int bound, int move) {
+	uint64_t data = (uint64_t) (uint16_t) (int16_t) value | ((uint64_t) bound << 16) | ((uint64_t) (move + 1) << 24);
+	endgame_entry_t *entry = &endgame->table[endgame->hash & (endgame->entries - 1)];
+	entry->check = endgame->hash ^ data;
+	entry->data = data;
+}
+
+static bool probe(const endgame_t *endgame, int *value, int *bound, int *move) {
+	const endgame_entry_t *entry = &endgame->table[endgame->hash & (endgame->entries - 1)];
+	uint64_t data = entry->data;
+	uint64_t check = entry->check;
+	if ((check ^ data) != endgame->hash || data == 0)
+		return false;
+
+	*value = (int16_t) (uint16_t) (data & 0xFFFF);
+	*bound = (int) ((data >> 16) & 0xFF);
+	*move = (int) ((data >> 24) & 0xFF) - 1;
+	return true;
+}
+
+static bool limits_reached(endgame_t *endgame) {
+	if (endgame->nodes > ENDGAME_NODE_LIMIT)
+		return true;
+	if (endgame->deadline == NULL)
+		return false;
+	struct timespec now;
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return now.tv_sec > endgame->deadline->tv_sec ||
+		   (now.tv_sec == endgame->deadline->tv_sec && now.tv_nsec >= endgame->deadline->tv_nsec);
+}
+
+/**
+ * @brief Negamax con alfa-beta y tabla de transposicion
+ * @param side Indice en endgame->players del jugador que mueve
+ * @return Ganancia del jugador que mueve menos la del rival (o su ganancia, si esta solo)
+ */
+static int search(endgame_t *endgame, engine_state_t *state, int side, int alpha, int beta, int ply) {
+	if ((++endgame->nodes & 4095) == 0 && limits_reached(endgame)) {
+		endgame->aborted = true;
+	}
+	if (endgame->aborted)
+		return 0;
+
+	int value, bound, hint = -1;
+	if (probe(endgame, &value, &bound, &hint) && ply > 0) {
+		if (bound == BOUND_EXACT)
+			return value;
+		if (bound == BOUND_LOWER && value > alpha)
+			alpha = value;
+		if (bound == BOUND_UPPER && value < beta)
+			beta = value;
+		if (alpha >= beta)
+			return value;
+	}
+
+	bool two_players = endgame->player_count == 2;
+	int player_id = endgame->players[side];
+	int other = two_players ? 1 - side : side;
+	engine_player_t *player = &state->players[player_id];
+
+	// Movimientos ordenados por recompensa, con el mejor de la tabla primero
+	int moves[ENGINE_DIRECTIONS], rewards[ENGINE_DIRECTIONS], move_count = 0;
+	for (int dir = 0; dir < ENGINE_DIRECTIONS; dir++) {
+		int nx, ny;
+		if (!engine_target(state->board, state->width, state->height, player->x, player->y, (direction_t) dir, &nx,
+						   &ny))
+			continue;
+		int reward = state->board[ny * state->width + nx] + (dir == hint ? ENDGAME_INFINITY : 0);
+		int i = move_count++;
+		while (i > 0 && rewards[i - 1] < reward) {
+			moves[i] = moves[i - 1];
+			rewards[i] = rewards[i - 1];
+			i--;
+		}
+		moves[i] = dir;
+		rewards[i] = reward;
+	}
+
+	if (move_count == 0) {
+		if (!two_players || !engine_has_valid_moves(state, endgame->players[other]))
+			return 0;
+
+		// Sin movimientos pasa el turno al rival
+		uint64_t flip = side_key(player_id) ^ side_key(endgame->players[other]);
+		endgame->hash ^= flip;
+		int result = -search(endgame, state, other, -beta, -alpha, ply + 1);
+		endgame->hash ^= flip;
+		return result;
+	}
+
+	int original_alpha = alpha;
+	int best = -ENDGAME_INFINITY;
+	int best_move = moves[0];
+
+	for (int i = 0; i < move_count; i++) {
+		int dir = moves[i];
+		int from = player->y * state->width + player->x;
+		int nx, ny;
+		engine_target(state->board, state->width, state->height, player->x, player->y, (direction_t) dir, &nx, &ny);
+		int to = ny * state->width + nx;
+		int reward = state->board[to];
+
+		uint64_t delta = cell_key(endgame, to, reward) ^ position_key(endgame, player_id, from) ^
+						 position_key(endgame, player_id, to);
+		if (two_players) {
+			delta ^= side_key(player_id) ^ side_key(endgame->players[other]);
+		}
+
+		engine_undo_t undo;
+		endgame->hash ^= delta;
+		engine_apply_move(state, player_id, (direction_t) dir, &undo);
+		int result = two_players ? reward - search(endgame, state, other, reward - beta, reward - alpha, ply + 1)
+								 : reward + search(endgame, state, side, alpha - reward, beta - reward, ply + 1);
+		engine_undo_move(state, &undo);
+		endgame->hash ^= delta;
+
+		if (endgame->aborted)
+			return 0;
+
+		if (result > best) {
+			best = result;
+			best_move = dir;
+		}
+		if (best > alpha)
+			alpha = best;
+		if (alpha >= beta)
+			break;
+	}
+
+	bound = (best <= original_alpha) ? BOUND_UPPER : (best >= beta) ? BOUND_LOWER : BOUND_EXACT;
+	store(endgame, best, bound, best_move);
+	if (ply == 0) {
+		endgame->root_move = best_move;
+	}
+	return best;
+}
+
+bool endgame_solve(endgame_t *endgame, engine_state_t *state, int player_id, const struct timespec *deadline,
+				   direction_t *move) {
+	if (endgame->table == NULL || state->players[player_id].is_blocked)
+		return false;
+
+	int count = find_region(endgame, state, player_id);
+	if (count <= 0)
+		return false;
+
+	// Hash inicial: celdas libres de la region, posiciones y jugador que mueve
+	endgame->hash = 0;
+	for (int i = 0; i < count; i++) {
+		endgame->hash ^= cell_key(endgame, endgame->queue[i], state->board[endgame->queue[i]]);
+	}
+	for (int i = 0; i < endgame->player_count; i++) {
+		const engine_player_t *player = &state->players[endgame->players[i]];
+		endgame->hash ^= position_key(endgame, endgame->players[i], player->y * state->width + player->x);
+	}
+	if (endgame->player_count == 2) {
+		endgame->hash ^= side_key(player_id);
+	}
+
+	endgame->deadline = deadline;
+	endgame->aborted = false;
+	endgame->nodes = 0;
+	endgame->root_move = -1;
+
+	search(endgame, state, 0, -ENDGAME_INFINITY, ENDGAME_INFINITY, 0);
+
+	if (endgame->aborted || endgame->root_move == -1)
+		return false;
+
+	*move = (direction_t) endgame->root_move;
+	return true;
+}
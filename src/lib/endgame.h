@@ -0,0 +1,99 @@
+#ifndef ENDGAME_H
+#define ENDGAME_H
+
+#include "common.h"
+#include "engine.h"
+#include <stdint.h>
+#include <time.h>
+
+/*
+ * Solver exacto de finales.
+ *
+ * Cuando la region libre alcanzable desde el jugador queda cerrada (solo la pueden tocar el jugador y a lo sumo un
+ * rival) y es chica, se resuelve con negamax alfa-beta asumiendo turnos alternados: el valor es la diferencia entre
+ * lo que suma el jugador y lo que suma el rival desde esa posicion.
+ *
+ * Las posiciones se identifican con hashing de Zobrist sobre las celdas libres de la region (con su recompensa), las
+ * posiciones de los jugadores involucrados y el jugador que mueve. Las claves se derivan de la celda y no de una
+ * tabla aleatoria, asi que el mismo final tiene el mismo hash en cualquier proceso y en cualquier partida. La tabla
+ * de transposicion vive en memoria compartida y se accede sin locks (cada entrada guarda clave ^ dato para detectar
+ * escrituras concurrentes), de modo que se reutiliza entre turnos y entre jugadores. Las claves incluyen el ancho y el
+ * alto del tablero, asi que partidas de distinto tamaño pueden compartir la tabla sin mezclar posiciones.
+ *
+ * Vida de la tabla: la crea el primer jugador que usa el solver y queda en /dev/shm despues de la partida, para que
+ * las siguientes (por ejemplo con la misma semilla) reutilicen los finales ya resueltos; se borra a mano con
+ * rm /dev/shm/chomp_endgame_tt. Es global a proposito: no pasa por shm_name, asi que la comparten todas las partidas
+ * del usuario, incluidas las que corren a la vez en otros espacios de nombres (tournament), y ningun master la borra
+ * mientras otros jugadores la usan. Con $CHOMP_ENDGAME_TT=drop el master la desvincula al terminar
+ * (endgame_unlink_shared) y con "private" cada proceso usa su propia tabla.
+ */
+
+#define ENDGAME_MAX_CELLS 40		  // Tamaño maximo de la region a resolver
+#define ENDGAME_MAX_PLAYERS 2		  // Jugadores que pueden compartir la region
+#define ENDGAME_NODE_LIMIT 4000000UL  // Nodos por busqueda antes de abandonar
+#define ENDGAME_TT_BITS 20			  // 2^20 entradas (16 MB)
+#define ENDGAME_TT_SHM "/chomp_endgame_tt"
+#define ENDGAME_TT_ENV "CHOMP_ENDGAME_TT" // "private": tabla propia del proceso; "drop": se borra al terminar
+
+// Entrada de la tabla de transposicion
+typedef struct {
+	volatile uint64_t check; // Hash ^ data (si no coincide, la entrada es de otra posicion o esta a medio escribir)
+	volatile uint64_t data;	 // Valor, tipo de cota y mejor movimiento
+} endgame_entry_t;
+
+typedef struct {
+	endgame_entry_t *table; // Tabla de transposicion
+	size_t entries;			// Cantidad de entradas (potencia de 2)
+	bool shared;			// Si la tabla esta en memoria compartida
+	int width;				// Ancho del tablero
+	int height;				// Alto del tablero
+	uint64_t board_key;		// Clave del tablero (ancho y alto) que se mezcla en las claves de celdas y posiciones
+	unsigned int *mark;		// Marcas de la busqueda de la region (una por celda)
+	unsigned int stamp;		// Marca de la busqueda actual
+	int *queue;				// Cola de la busqueda de la region
+
+	int players[ENDGAME_MAX_PLAYERS]; // Jugadores involucrados en el final (el primero es el que busca)
+	int player_count;				  // Cantidad de jugadores involucrados
+	uint64_t hash;					  // Hash de Zobrist de la posicion actual (se actualiza en cada movimiento)
+	const struct timespec *deadline;  // Limite de tiempo de la busqueda (CLOCK_MONOTONIC, puede ser NULL)
+	bool aborted;					  // La busqueda supero el limite de nodos o de tiempo
+	int root_move;					  // Mejor movimiento de la raiz
+	unsigned long nodes;			  // Nodos visitados por la busqueda actual
+} endgame_t;
+
+/**
+ * @brief Reserva las estructuras del solver y conecta la tabla de transposicion
+ * @param endgame Solver a inicializar
+ * @param width Ancho del tablero
+ * @param height Alto del tablero
+ * @return 0 si la inicializacion fue exitosa, -1 en caso de error
+ * @details La tabla se abre en ENDGAME_TT_SHM (se crea si no existe); si no se puede, o si $CHOMP_ENDGAME_TT es
+ * "private", se usa memoria privada.
+ */
+int endgame_create(endgame_t *endgame, int width, int height);
+
+/**
+ * @brief Desvincula la tabla compartida al terminar la partida (solo si $CHOMP_ENDGAME_TT es "drop")
+ * @details Lo llama el master; los procesos que todavia la tienen mapeada la siguen usando hasta liberarla.
+ */
+void endgame_unlink_shared(void);
+
+/**
+ * @brief Libera el solver (la tabla compartida queda para los otros jugadores de la partida)
+ * @param endgame Solver a liberar
+ */
+void endgame_destroy(endgame_t *endgame);
+
+/**
+ * @brief Intenta resolver exactamente el final del jugador
+ * @param endgame Solver
+ * @param state Estado del motor (se modifica durante la busqueda y se restaura antes de volver)
+ * @param player_id Jugador que busca
+ * @param deadline Limite de tiempo (CLOCK_MONOTONIC) o NULL
+ * @param move Movimiento optimo si la funcion devuelve true
+ * @return true si la region es cerrada, chica y se resolvio dentro de los limites
+ */
+bool endgame_solve(endgame_t *endgame, engine_state_t *state, int player_id, const struct timespec *deadline,
+				   direction_t *move);
+
+#endif // ENDGAME_H
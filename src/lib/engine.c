@@ -0,0 +1,285 @@
+// This is a personal academic project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: https://pvs-studio.com
+#include "engine.h"
+#include "common.h"
+#include <stdlib.h>
+#include <string.h>
+
+void engine_direction_offset(direction_t dir, int *dx, int *dy) {
+	static const int offsets[][2] = {
+		{0, -1}, // UP
+		{1, -1}, // UP_RIGHT
+		{1, 0},	 // RIGHT
+		{1, 1},	 // DOWN_RIGHT
+		{0, 1},	 // DOWN
+		{-1, 1}, // DOWN_LEFT
+		{-1, 0}, // LEFT
+		{-1, -1} // UP_LEFT
+	};
+	*dx = offsets[dir][0];
+	*dy = offsets[dir][1];
+}
+
+void engine_fill_board(int *board, int cells, unsigned int seed) {
+	srand(seed);
+
+	for (int i = 0; i < cells; i++) {
+		board[i] = (rand() % ENGINE_MAX_REWARD) + ENGINE_MIN_REWARD;
+	}
+}
+
+void engine_start_position(int player_id, int player_count, int width, int height, unsigned short *x,
+						   unsigned short *y) {
+	// Distribucion simple: esquinas y bordes
+	if (player_id < 4) {
+		// Primeros 4 jugadores en las esquinas
+		switch (player_id) {
+			case 0:
+				*x = 0;
+				*y = 0;
+				break;
+			case 1:
+				*x = width - 1;
+				*y = 0;
+				break;
+			case 2:
+				*x = 0;
+				*y = height - 1;
+				break;
+			case 3:
+				*x = width - 1;
+				*y = height - 1;
+				break;
+		}
+	}
+	else {
+		// Jugadores adicionales en los bordes
+		int side = (player_id - 4) % 4;
+		int pos = (player_id - 4) / 4 + 1;
+
+		switch (side) {
+			case 0: // Borde superior
+				*x = pos * width / (player_count - 3);
+				*y = 0;
+				break;
+			case 1: // Borde derecho
+				*x = width - 1;
+				*y = pos * height / (player_count - 3);
+				break;
+			case 2: // Borde inferior
+				*x = width - 1 - pos * width / (player_count - 3);
+				*y = height - 1;
+				break;
+			case 3: // Borde izquierdo
+				*x = 0;
+				*y = height - 1 - pos * height / (player_count - 3);
+				break;
+		}
+	}
+}
+
+bool engine_target(const int *board, int width, int height, int x, int y, direction_t direction, int *new_x,
+				   int *new_y) {
+	// El byte recibido por el pipe puede no ser una direccion
+	if ((unsigned int) direction > DIR_UP_LEFT) {
+		return false;
+	}
+
+	int dx, dy;
+	engine_direction_offset(direction, &dx, &dy);
+	int target_x = x + dx;
+	int target_y = y + dy;
+
+	if (new_x != NULL)
+		*new_x = target_x;
+	if (new_y != NULL)
+		*new_y = target_y;
+
+	// Validacion de que la nueva posicion este dentro del tablero
+	if (target_x < 0 || target_y < 0 || target_x >= width || target_y >= height) {
+		return false;
+	}
+
+	// Validar que no este ocupado
+	return board[target_y * width + target_x] > 0;
+}
+
+int engine_create(engine_state_t *state, unsigned short width, unsigned short height, unsigned int player_count) {
+	memset(state, 0, sizeof(*state));
+
+	if (player_count == 0 || player_count > MAX_PLAYERS) {
+		return -1;
+	}
+
+	state->board = malloc((size_t) width * height * sizeof(int));
+	if (state->board == NULL) {
+		return -1;
+	}
+
+	state->width = width;
+	state->height = height;
+	state->player_count = player_count;
+	return 0;
+}
+
+void engine_destroy(engine_state_t *state) {
+	free(state->board);
+	state->board = NULL;
+}
+
+void engine_reset(engine_state_t *state, unsigned int seed) {
+	engine_fill_board(state->board, state->width * state->height, seed);
+
+	for (unsigned int i = 0; i < state->player_count; i++) {
+		engine_player_t *player = &state->players[i];
+		memset(player, 0, sizeof(*player));
+		engine_start_position((int) i, (int) state->player_count, state->width, state->height, &player->x,
+							  &player->y);
+
+		// Marcar celda como ocupada
+		*engine_cell(state, player->x, player->y) = -(int) i;
+	}
+}
+
+void engine_copy(engine_state_t *dst, const engine_state_t *src) {
+	dst->player_count = src->player_count;
+	memcpy(dst->players, src->players, sizeof(dst->players));
+	memcpy(dst->board, src->board, (size_t) src->width * src->height * sizeof(int));
+}
+
+void engine_load_game_state(engine_state_t *dst, const game_state_t *src) {
+	dst->player_count = src->player_count;
+	for (unsigned int i = 0; i < src->player_count; i++) {
+		dst->players[i].score = src->players[i].score;
+		dst->players[i].valid_moves = src->players[i].valid_moves;
+		dst->players[i].invalid_moves = src->players[i].invalid_moves;
+		dst->players[i].x = src->players[i].x;
+		dst->players[i].y = src->players[i].y;
+		dst->players[i].is_blocked = src->players[i].is_blocked;
+	}
+	memcpy(dst->board, src->board, (size_t) src->width * src->height * sizeof(int));
+}
+
+int *engine_cell(const engine_state_t *state, int x, int y) {
+	return &state->board[y * state->width + x];
+}
+
+bool engine_is_valid_move(const engine_state_t *state, int player_id, direction_t direction) {
+	const engine_player_t *player = &state->players[player_id];
+	return engine_target(state->board, state->width, state->height, player->x, player->y, direction, NULL, NULL);
+}
+
+/**
+ * @brief Ocupa la celda destino de un movimiento valido (regla compartida por engine_state_t y game_state_t)
+ * @return Recompensa de la celda
+ */
+static int take_cell(int *board, int width, int x, int y, int player_id) {
+	int *cell = &board[y * width + x];
+	int reward = *cell;
+	*cell = -player_id;
+	return reward;
+}
+
+/**
+ * @brief Verifica si desde una posicion hay algun movimiento valido
+ */
+static bool can_move(const int *board, int width, int height, int x, int y) {
+	for (int dir = 0; dir < ENGINE_DIRECTIONS; dir++) {
+		if (engine_target(board, width, height, x, y, (direction_t) dir, NULL, NULL)) {
+			return true;
+		}
+	}
+	return false;
+}
+
+/**
+ * @brief Regla de fin de juego para un jugador: si no tiene movimientos validos queda bloqueado
+ * @return true si el jugador sigue activo
+ */
+static bool update_blocked(const int *board, int width, int height, int x, int y, bool *is_blocked) {
+	if (*is_blocked)
+		return false;
+	*is_blocked = !can_move(board, width, height, x, y);
+	return !*is_blocked;
+}
+
+bool engine_apply_move(engine_state_t *state, int player_id, direction_t direction, engine_undo_t *undo) {
+	engine_player_t *player = &state->players[player_id];
+	int new_x, new_y;
+	bool valid = engine_target(state->board, state->width, state->height, player->x, player->y, direction, &new_x,
+							   &new_y);
+
+	if (undo != NULL) {
+		undo->player_id = (unsigned char) player_id;
+		undo->valid = valid;
+		undo->prev_x = player->x;
+		undo->prev_y = player->y;
+		undo->prev_cell = valid ? *engine_cell(state, new_x, new_y) : 0;
+	}
+
+	if (!valid) {
+		player->invalid_moves++;
+		return false;
+	}
+
+	player->score += take_cell(state->board, state->width, new_x, new_y, player_id);
+	player->x = new_x;
+	player->y = new_y;
+	player->valid_moves++;
+	return true;
+}
+
+bool engine_game_apply_move(game_state_t *state, int player_id, direction_t direction) {
+	player_t *player = &state->players[player_id];
+	int new_x, new_y;
+	if (!engine_target(state->board, state->width, state->height, player->x, player->y, direction, &new_x, &new_y)) {
+		player->invalid_moves++;
+		return false;
+	}
+
+	player->score += take_cell(state->board, state->width, new_x, new_y, player_id);
+	player->x = new_x;
+	player->y = new_y;
+	player->valid_moves++;
+	return true;
+}
+
+void engine_undo_move(engine_state_t *state, const engine_undo_t *undo) {
+	engine_player_t *player = &state->players[undo->player_id];
+
+	if (!undo->valid) {
+		player->invalid_moves--;
+		return;
+	}
+
+	*engine_cell(state, player->x, player->y) = undo->prev_cell;
+	player->score -= undo->prev_cell;
+	player->valid_moves--;
+	player->x = undo->prev_x;
+	player->y = undo->prev_y;
+}
+
+bool engine_has_valid_moves(const engine_state_t *state, int player_id) {
+	const engine_player_t *player = &state->players[player_id];
+	return can_move(state->board, state->width, state->height, player->x, player->y);
+}
+
+bool engine_check_end(engine_state_t *state) {
+	bool any_active = false;
+	for (unsigned int i = 0; i < state->player_count; i++) {
+		engine_player_t *player = &state->players[i];
+		any_active |= update_blocked(state->board, state->width, state->height, player->x, player->y,
+									 &player->is_blocked);
+	}
+	return !any_active;
+}
+
+bool engine_game_check_end(game_state_t *state) {
+	bool any_active = false;
+	for (unsigned int i = 0; i < state->player_count; i++) {
+		player_t *player = &state->players[i];
+		any_active |= update_blocked(state->board, state->width, state->height, player->x, player->y,
+									 &player->is_blocked);
+	}
+	return !any_active;
+}
@@ -0,0 +1,193 @@
+#ifndef ENGINE_H
+#define ENGINE_H
+
+#include "common.h"
+
+/*
+ * Motor del juego independiente de la memoria compartida y de los procesos.
+ * Las reglas (generacion del tablero, posiciones iniciales, validacion y aplicacion de movimientos) viven aca y
+ * las funciones que operan sobre game_state_t las reutilizan, de modo que el master, los jugadores, el verificador
+ * y las estrategias de busqueda simulan exactamente las mismas reglas.
+ *
+ * El tablero usa la misma codificacion que game_state_t: valores > 0 son recompensas libres y valores <= 0 son
+ * celdas ocupadas por el jugador -(valor).
+ */
+
+#define ENGINE_DIRECTIONS 8
+#define ENGINE_MIN_REWARD 1
+#define ENGINE_MAX_REWARD 9
+
+// Jugador dentro del motor
+typedef struct {
+	unsigned int score;			// Puntaje
+	unsigned int valid_moves;	// Cantidad de movimientos validos
+	unsigned int invalid_moves; // Cantidad de movimientos invalidos
+	unsigned short x, y;		// Coordenadas x e y en el tablero
+	bool is_blocked;			// Indica si el jugador esta bloqueado
+} engine_player_t;
+
+// Estado del motor (memoria privada del proceso)
+typedef struct {
+	unsigned short width;				  // Ancho del tablero
+	unsigned short height;				  // Alto del tablero
+	unsigned int player_count;			  // Cantidad de jugadores
+	engine_player_t players[MAX_PLAYERS]; // Lista de jugadores
+	int *board;							  // Tablero (width * height celdas)
+} engine_state_t;
+
+// Informacion necesaria para deshacer un movimiento
+typedef struct {
+	unsigned char player_id; // Jugador que movio
+	bool valid;				 // Si el movimiento fue valido
+	unsigned short prev_x;	 // Posicion x anterior
+	unsigned short prev_y;	 // Posicion y anterior
+	int prev_cell;			 // Contenido anterior de la celda destino
+} engine_undo_t;
+
+/**
+ * @brief Obtiene el desplazamiento en x e y segun la direccion
+ * @param dir Direccion del movimiento
+ * @param dx Puntero para almacenar el desplazamiento en x
+ * @param dy Puntero para almacenar el desplazamiento en y
+ */
+void engine_direction_offset(direction_t dir, int *dx, int *dy);
+
+/**
+ * @brief Llena un tablero con recompensas aleatorias (1-9) a partir de una semilla
+ * @param board Tablero a llenar
+ * @param cells Cantidad de celdas
+ * @param seed Semilla de generacion
+ */
+void engine_fill_board(int *board, int cells, unsigned int seed);
+
+/**
+ * @brief Calcula la posicion inicial de un jugador (esquinas y luego bordes)
+ * @param player_id ID del jugador
+ * @param player_count Cantidad de jugadores en la partida
+ * @param width Ancho del tablero
+ * @param height Alto del tablero
+ * @param x Puntero para almacenar la coordenada x
+ * @param y Puntero para almacenar la coordenada y
+ */
+void engine_start_position(int player_id, int player_count, int width, int height, unsigned short *x,
+						   unsigned short *y);
+
+/**
+ * @brief Calcula la celda destino de un movimiento y verifica si es valida
+ * @param board Tablero
+ * @param width Ancho del tablero
+ * @param height Alto del tablero
+ * @param x Coordenada x actual
+ * @param y Coordenada y actual
+ * @param direction Direccion del movimiento
+ * @param new_x Puntero para almacenar la coordenada x destino (puede ser NULL)
+ * @param new_y Puntero para almacenar la coordenada y destino (puede ser NULL)
+ * @return true si el destino esta dentro del tablero y libre, false en caso contrario
+ */
+bool engine_target(const int *board, int width, int height, int x, int y, direction_t direction, int *new_x,
+				   int *new_y);
+
+/**
+ * @brief Reserva el tablero de un estado del motor
+ * @param state Estado a inicializar
+ * @param width Ancho del tablero
+ * @param height Alto del tablero
+ * @param player_count Cantidad de jugadores (1-9)
+ * @return 0 si la reserva fue exitosa, -1 en caso de error
+ */
+int engine_create(engine_state_t *state, unsigned short width, unsigned short height, unsigned int player_count);
+
+/**
+ * @brief Libera el tablero de un estado del motor
+ * @param state Estado a liberar
+ */
+void engine_destroy(engine_state_t *state);
+
+/**
+ * @brief Genera el tablero y posiciona a los jugadores igual que initialize_game_state
+ * @param state Estado creado con engine_create
+ * @param seed Semilla de generacion
+ */
+void engine_reset(engine_state_t *state, unsigned int seed);
+
+/**
+ * @brief Copia un estado del motor sobre otro de las mismas dimensiones
+ * @param dst Estado destino
+ * @param src Estado origen
+ */
+void engine_copy(engine_state_t *dst, const engine_state_t *src);
+
+/**
+ * @brief Copia el estado de una partida (por ejemplo la memoria compartida) al motor
+ * @param dst Estado destino creado con las mismas dimensiones
+ * @param src Estado del juego origen
+ */
+void engine_load_game_state(engine_state_t *dst, const game_state_t *src);
+
+/**
+ * @brief Obtiene un puntero a la celda del tablero
+ * @param state Estado del motor
+ * @param x Coordenada x
+ * @param y Coordenada y
+ * @return Puntero a la celda
+ */
+int *engine_cell(const engine_state_t *state, int x, int y);
+
+/**
+ * @brief Verifica si un movimiento es valido para un jugador
+ * @param state Estado del motor
+ * @param player_id ID del jugador
+ * @param direction Direccion del movimiento
+ * @return true si el movimiento es valido, false en caso contrario
+ */
+bool engine_is_valid_move(const engine_state_t *state, int player_id, direction_t direction);
+
+/**
+ * @brief Aplica un movimiento con las mismas reglas que el master
+ * @param state Estado del motor
+ * @param player_id ID del jugador
+ * @param direction Direccion del movimiento
+ * @param undo Informacion para deshacer el movimiento (puede ser NULL)
+ * @return true si el movimiento fue valido, false si se conto como invalido
+ */
+bool engine_apply_move(engine_state_t *state, int player_id, direction_t direction, engine_undo_t *undo);
+
+/**
+ * @brief Aplica un movimiento sobre el estado de una partida (por ejemplo la memoria compartida del master)
+ * @param state Estado del juego
+ * @param player_id ID del jugador
+ * @param direction Direccion del movimiento
+ * @return true si el movimiento fue valido, false si se conto como invalido
+ */
+bool engine_game_apply_move(game_state_t *state, int player_id, direction_t direction);
+
+/**
+ * @brief Deshace el ultimo movimiento aplicado con engine_apply_move
+ * @param state Estado del motor
+ * @param undo Informacion devuelta por engine_apply_move
+ */
+void engine_undo_move(engine_state_t *state, const engine_undo_t *undo);
+
+/**
+ * @brief Verifica si un jugador tiene algun movimiento valido
+ * @param state Estado del motor
+ * @param player_id ID del jugador
+ * @return true si tiene al menos un movimiento valido
+ */
+bool engine_has_valid_moves(const engine_state_t *state, int player_id);
+
+/**
+ * @brief Marca como bloqueados a los jugadores sin movimientos y verifica si el juego termino
+ * @param state Estado del motor
+ * @return true si ningun jugador puede moverse, false en caso contrario
+ */
+bool engine_check_end(engine_state_t *state);
+
+/**
+ * @brief Igual que engine_check_end sobre el estado de una partida
+ * @param state Estado del juego
+ * @return true si ningun jugador puede moverse, false en caso contrario
+ */
+bool engine_game_check_end(game_state_t *state);
+
+#endif // ENGINE_H
@@ -2,12 +2,20 @@
 // PVS-Studio Static Code Analyzer for C, C++, C#, and Java: https://pvs-studio.com
 #define _GNU_SOURCE
 #include "game_logic.h"
+#include "analytics.h"
 #include "common.h"
+#include "engine.h"
+#include "game_record.h"
 #include "library.h"
+#include "live_stats.h"
+#include "lock_stats.h"
 #include "process_management.h"
+#include "syscall_stats.h"
+#include "trace.h"
 #include <errno.h>
 #include <semaphore.h>
 #include <stdio.h>
+#include <string.h>
 #include <sys/select.h>
 #include <time.h>
 #include <unistd.h>
@@ -17,6 +25,7 @@ int sem_wait_with_timeout(sem_t *sem, int timeout_sec) {
 	clock_gettime(CLOCK_REALTIME, &timeout);
 	timeout.tv_sec += timeout_sec;
 
+	syscall_count(SYSCALL_SEM_TIMEDWAIT);
 	int result = sem_timedwait(sem, &timeout);
 	if (result == -1 && errno == ETIMEDOUT) {
 		return -1;
@@ -24,48 +33,77 @@ int sem_wait_with_timeout(sem_t *sem, int timeout_sec) {
 	return result;
 }
 
-void execute_player_move(master_context_t *ctx, int player_id, unsigned char direction) {
-	player_t *player = &ctx->game_state->players[player_id];
-	int dx, dy;
-	get_direction_offset((direction_t) direction, &dx, &dy);
+static double elapsed_ms(const struct timespec *since) {
+	struct timespec now;
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return (now.tv_sec - since->tv_sec) * 1000.0 + (now.tv_nsec - since->tv_nsec) / 1000000.0;
+}
 
-	int new_x = player->x + dx;
-	int new_y = player->y + dy;
+static unsigned long long now_ns(void) {
+	struct timespec now;
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return (unsigned long long) now.tv_sec * 1000000000ULL + (unsigned long long) now.tv_nsec;
+}
 
-	int *cell = get_cell(ctx->game_state, new_x, new_y);
-	int reward = *cell;
+void grant_turn(master_context_t *ctx, int player_id) {
+	ctx->turn_granted_ns[player_id] = now_ns();
+	syscall_count(SYSCALL_SEM_POST);
+	sem_post(&ctx->game_sync->player_turn[player_id]);
+}
 
-	player->x = new_x;
-	player->y = new_y;
-	player->score += reward;
-	player->valid_moves++;
+void print_latency(const master_context_t *ctx) {
+	printf("\n=== TURN LATENCY (us) ===\n");
+	printf("%-12s %8s %10s %10s %10s %10s %10s\n", "Stage", "Count", "Avg", "p50", "p90", "p99", "Max");
 
-	*cell = -(player_id);
+	// Una fila por jugador debajo del total de todos los turnos
+	histogram_t turn = {0};
+	for (int i = 0; i < ctx->config.player_count; i++) {
+		histogram_merge(&turn, &ctx->turn_latency[i]);
+	}
+	histogram_print(stdout, "turn", &turn);
+	for (int i = 0; i < ctx->config.player_count; i++) {
+		char name[16];
+		snprintf(name, sizeof(name), "  P%d", i + 1);
+		histogram_print(stdout, name, &ctx->turn_latency[i]);
+	}
+	histogram_print(stdout, "apply", &ctx->apply_latency);
+	if (ctx->view_latency.count > 0) {
+		histogram_print(stdout, "view sync", &ctx->view_latency);
+	}
+	printf("=========================\n");
 }
 
-bool check_game_end(master_context_t *ctx) {
-	bool any_active = false;
+int wait_players_ready(master_context_t *ctx, int timeout_sec) {
+	struct timespec deadline;
+	clock_gettime(CLOCK_REALTIME, &deadline);
+	deadline.tv_sec += timeout_sec;
 
-	for (int player_id = 0; player_id < ctx->config.player_count; player_id++) {
-		if (ctx->game_state->players[player_id].is_blocked)
-			continue;
-
-		bool has_valid_moves = false;
-		for (unsigned char dir = 0; dir < 8; dir++) {
-			if (is_valid_move(player_id, dir, ctx->game_state)) {
-				has_valid_moves = true;
-				any_active = true;
-				break;
-			}
+	int ready = 0;
+	while (ready < ctx->config.player_count) {
+		syscall_count(SYSCALL_SEM_TIMEDWAIT);
+		if (sem_timedwait(&ctx->game_sync->players_ready, &deadline) == 0) {
+			ready++;
 		}
-
-		if (!has_valid_moves && !ctx->game_state->players[player_id].is_blocked) {
-			// Marcamos el jugador como bloqueado y esperamos que el jugador lo maneje
-			ctx->game_state->players[player_id].is_blocked = true;
+		else if (errno != EINTR) {
+			break;
 		}
 	}
+	ctx->ready_ms = elapsed_ms(&ctx->start_time);
+	return ready;
+}
+
+void print_startup_times(const master_context_t *ctx) {
+	printf("Startup: players ready after %.3f ms, first move after %.3f ms, last move after %.3f ms\n", ctx->ready_ms,
+		   ctx->first_move_ms, ctx->last_move_ms);
+}
+
+void execute_player_move(master_context_t *ctx, int player_id, unsigned char direction) {
+	engine_game_apply_move(ctx->game_state, player_id, (direction_t) direction);
+}
 
-	return !any_active;
+bool check_game_end(master_context_t *ctx) {
+	// Los jugadores sin movimientos quedan bloqueados y cada uno lo maneja al verlo
+	return engine_game_check_end(ctx->game_state);
 }
 
 void sync_with_view(master_context_t *ctx) {
@@ -79,6 +117,7 @@ void sync_with_view(master_context_t *ctx) {
 	}
 
 	// Notificar a view
+	syscall_count(SYSCALL_SEM_POST);
 	if (sem_post(&ctx->game_sync->view_ready) == -1) {
 		perror("Error signaling view");
 		ctx->view_active = false;
@@ -86,18 +125,162 @@ void sync_with_view(master_context_t *ctx) {
 	}
 
 	// Esperar respuesta con timeout
-	if (sem_wait_with_timeout(&ctx->game_sync->view_done, VIEW_TIMEOUT_SEC) == -1) {
+	unsigned long long start = now_ns();
+	if (spin_wait(&ctx->game_sync->view_done, VIEW_TIMEOUT_SEC, &ctx->view_done_wait) == -1) {
 		ctx->view_active = false;
 		return;
 	}
+	histogram_record(&ctx->view_latency, now_ns() - start);
+	live_stats_frame(ctx);
+}
+
+/**
+ * @brief Toma el estado como escritor (C y luego D, como los lectores) y registra la espera
+ * @param ctx Puntero al contexto del master
+ * @param received Momento en que se recibio el movimiento
+ * @return Espera en ns desde received
+ */
+static unsigned long long writer_enter(master_context_t *ctx, unsigned long long received) {
+	// Con --lock-stats se mide cuanto espera el master (unico escritor) a que salgan los lectores
+	lock_slot_t *slot = (ctx->lock_stats != NULL) ? &ctx->lock_stats->slots[LOCK_STATS_MASTER] : NULL;
+	lock_enter(slot, LOCK_READER_WRITER, &ctx->game_sync->reader_writer_mutex);
+	lock_enter(slot, LOCK_STATE, &ctx->game_sync->state_mutex);
+	lock_exit(slot, LOCK_READER_WRITER, &ctx->game_sync->reader_writer_mutex);
+	unsigned long long lock_wait = now_ns() - received;
+	if (ctx->lock_stats != NULL) {
+		histogram_record(&ctx->lock_stats->writer_wait, lock_wait);
+	}
+	return lock_wait;
 }
 
-// Funcion auxiliar para configurar file descriptors
-static void setup_file_descriptors(master_context_t *ctx, fd_set *readfds, int *max_fd) {
+static void writer_exit(master_context_t *ctx) {
+	lock_slot_t *slot = (ctx->lock_stats != NULL) ? &ctx->lock_stats->slots[LOCK_STATS_MASTER] : NULL;
+	lock_exit(slot, LOCK_STATE, &ctx->game_sync->state_mutex);
+}
+
+/**
+ * @brief Valida y ejecuta un movimiento (con el estado tomado como escritor)
+ * @return true si el movimiento fue valido
+ */
+static bool validate_and_execute(master_context_t *ctx, int player_id, unsigned char move, time_t *last_valid_move) {
+	unsigned long long span = trace_now(ctx->trace_ring);
+	bool valid = is_valid_move(player_id, move, ctx->game_state);
+	trace_span(ctx->trace_ring, TRACE_VALIDATE, span, (unsigned int) player_id);
+	if (valid) {
+		span = trace_now(ctx->trace_ring);
+		execute_player_move(ctx, player_id, move);
+		trace_span(ctx->trace_ring, TRACE_EXECUTE, span, (unsigned int) player_id);
+		*last_valid_move = time(NULL);
+	}
+	else {
+		ctx->game_state->players[player_id].invalid_moves++;
+	}
+	return valid;
+}
+
+/**
+ * @brief Publica un movimiento ya aplicado: estadisticas en vivo, tiempos de la partida y grabacion
+ */
+static void publish_move(master_context_t *ctx, int player_id, unsigned char move, bool valid,
+						 time_t last_valid_move, unsigned long long lock_wait) {
+	live_stats_move(ctx, player_id, valid, last_valid_move, lock_wait);
+	ctx->last_move_ms = elapsed_ms(&ctx->start_time);
+	if (ctx->first_move_ms == 0) {
+		ctx->first_move_ms = ctx->last_move_ms;
+	}
+	record_move(ctx, player_id, move);
+}
+
+void apply_player_move(master_context_t *ctx, int player_id, unsigned char move, time_t *last_valid_move) {
+	unsigned long long received = now_ns();
+	histogram_record(&ctx->turn_latency[player_id], received - ctx->turn_granted_ns[player_id]);
+
+	unsigned long long lock_wait = writer_enter(ctx, received);
+	bool valid = validate_and_execute(ctx, player_id, move, last_valid_move);
+	writer_exit(ctx);
+
+	histogram_record(&ctx->apply_latency, now_ns() - received);
+	publish_move(ctx, player_id, move, valid, *last_valid_move, lock_wait);
+	grant_turn(ctx, player_id);
+
+	// El master es el unico escritor: puede leer el estado sin el lock mientras los jugadores juegan
+	analytics_update(ctx);
+}
+
+void round_add(round_t *round, int player_id, unsigned char move) {
+	round_move_t *entry = &round->moves[round->count++];
+	entry->player_id = player_id;
+	entry->move = move;
+	entry->received_ns = now_ns();
+	round->submitted[player_id] = true;
+}
+
+bool round_complete(const master_context_t *ctx, const round_t *round) {
+	for (int i = 0; i < ctx->config.player_count; i++) {
+		if (!ctx->game_state->players[i].is_blocked && !round->submitted[i])
+			return false;
+	}
+	return round->count > 0;
+}
+
+/**
+ * @brief Prioridad de una colision: mayor puntaje y despues menor ID
+ * @return true si a se aplica antes que b
+ */
+static bool round_before(const game_state_t *state, const round_move_t *a, const round_move_t *b) {
+	unsigned int score_a = state->players[a->player_id].score, score_b = state->players[b->player_id].score;
+	return score_a > score_b || (score_a == score_b && a->player_id < b->player_id);
+}
+
+void apply_round(master_context_t *ctx, round_t *round, time_t *last_valid_move) {
+	unsigned long long received = now_ns();
+	for (int i = 0; i < round->count; i++) {
+		const round_move_t *entry = &round->moves[i];
+		histogram_record(&ctx->turn_latency[entry->player_id],
+						 entry->received_ns - ctx->turn_granted_ns[entry->player_id]);
+	}
+
+	// Orden de aplicacion (insercion: a lo sumo MAX_PLAYERS movimientos), con los puntajes del inicio de la ronda
+	for (int i = 1; i < round->count; i++) {
+		round_move_t entry = round->moves[i];
+		int j = i - 1;
+		while (j >= 0 && round_before(ctx->game_state, &entry, &round->moves[j])) {
+			round->moves[j + 1] = round->moves[j];
+			j--;
+		}
+		round->moves[j + 1] = entry;
+	}
+
+	bool valid[MAX_PLAYERS];
+	unsigned long long lock_wait = writer_enter(ctx, received);
+	for (int i = 0; i < round->count; i++) {
+		valid[i] = validate_and_execute(ctx, round->moves[i].player_id, round->moves[i].move, last_valid_move);
+	}
+	writer_exit(ctx);
+
+	histogram_record(&ctx->apply_latency, now_ns() - received);
+
+	// La espera por el lock es una sola por ronda: se cuenta con el primer movimiento
+	for (int i = 0; i < round->count; i++) {
+		publish_move(ctx, round->moves[i].player_id, round->moves[i].move, valid[i], *last_valid_move,
+					 i == 0 ? lock_wait : 0);
+	}
+	for (int i = 0; i < round->count; i++) {
+		grant_turn(ctx, round->moves[i].player_id);
+	}
+
+	analytics_update(ctx);
+	memset(round, 0, sizeof(*round));
+}
+
+// Funcion auxiliar para configurar file descriptors (con --rounds sin los jugadores que ya movieron en la ronda)
+static void setup_file_descriptors(master_context_t *ctx, fd_set *readfds, int *max_fd, const round_t *round) {
 	FD_ZERO(readfds);
 	*max_fd = 0;
 
 	for (int i = 0; i < ctx->config.player_count; i++) {
+		if (round != NULL && round->submitted[i])
+			continue;
 		if (!ctx->game_state->players[i].is_blocked && ctx->player_pipes[i] != -1) {
 			FD_SET(ctx->player_pipes[i], readfds);
 			if (ctx->player_pipes[i] > *max_fd) {
@@ -107,6 +290,24 @@ static void setup_file_descriptors(master_context_t *ctx, fd_set *readfds, int *
 	}
 }
 
+// Funcion auxiliar para leer un movimiento del pipe de un jugador (marca al jugador bloqueado si el pipe se cerro)
+static bool read_player_move(master_context_t *ctx, int player_id, unsigned char *move) {
+	unsigned long long span = trace_now(ctx->trace_ring);
+	syscall_count(SYSCALL_READ);
+	ssize_t bytes_read = read(ctx->player_pipes[player_id], move, 1);
+	trace_span(ctx->trace_ring, TRACE_READ, span, (unsigned int) player_id);
+
+	if (bytes_read <= 0) {
+		ctx->game_state->players[player_id].is_blocked = true;
+		if (ctx->player_pipes[player_id] != -1) {
+			close(ctx->player_pipes[player_id]);
+			ctx->player_pipes[player_id] = -1;
+		}
+		return false;
+	}
+	return true;
+}
+
 // Funcion auxiliar para procesar movimientos de jugadores
 static bool process_player_moves(master_context_t *ctx, fd_set *readfds, int *current_player, time_t *last_valid_move) {
 	bool movement_processed = false;
@@ -119,31 +320,11 @@ static bool process_player_moves(master_context_t *ctx, fd_set *readfds, int *cu
 		}
 
 		unsigned char move;
-		ssize_t bytes_read = read(ctx->player_pipes[player_id], &move, 1);
-
-		if (bytes_read <= 0) {
-			ctx->game_state->players[player_id].is_blocked = true;
-			if (ctx->player_pipes[player_id] != -1) {
-				close(ctx->player_pipes[player_id]);
-				ctx->player_pipes[player_id] = -1;
-			}
+		if (!read_player_move(ctx, player_id, &move)) {
 			continue;
 		}
 
-		sem_wait(&ctx->game_sync->reader_writer_mutex);
-		sem_wait(&ctx->game_sync->state_mutex);
-		sem_post(&ctx->game_sync->reader_writer_mutex);
-
-		if (is_valid_move(player_id, move, ctx->game_state)) {
-			execute_player_move(ctx, player_id, move);
-			*last_valid_move = time(NULL);
-		}
-		else {
-			ctx->game_state->players[player_id].invalid_moves++;
-		}
-
-		sem_post(&ctx->game_sync->state_mutex);
-		sem_post(&ctx->game_sync->player_turn[player_id]);
+		apply_player_move(ctx, player_id, move, last_valid_move);
 
 		movement_processed = true;
 		*current_player = (player_id + 1) % ctx->config.player_count;
@@ -152,6 +333,26 @@ static bool process_player_moves(master_context_t *ctx, fd_set *readfds, int *cu
 	return movement_processed;
 }
 
+// Funcion auxiliar para juntar los movimientos de una ronda (--rounds) y aplicarla cuando esta completa
+static bool process_round_moves(master_context_t *ctx, fd_set *readfds, round_t *round, time_t *last_valid_move) {
+	for (int player_id = 0; player_id < ctx->config.player_count; player_id++) {
+		if (round->submitted[player_id] || ctx->game_state->players[player_id].is_blocked ||
+			!FD_ISSET(ctx->player_pipes[player_id], readfds)) {
+			continue;
+		}
+
+		unsigned char move;
+		if (read_player_move(ctx, player_id, &move)) {
+			round_add(round, player_id, move);
+		}
+	}
+
+	if (!round_complete(ctx, round))
+		return false;
+	apply_round(ctx, round, last_valid_move);
+	return true;
+}
+
 // Funcion auxiliar para verificar timeout
 static bool check_timeout(master_context_t *ctx, time_t last_valid_move) {
 	return difftime(time(NULL), last_valid_move) >= ctx->config.timeout;
@@ -160,23 +361,29 @@ static bool check_timeout(master_context_t *ctx, time_t last_valid_move) {
 // Funcion auxiliar para notificar a todos los jugadores
 static void notify_all_players(master_context_t *ctx) {
 	for (int i = 0; i < ctx->config.player_count; i++) {
+		syscall_count(SYSCALL_SEM_POST);
 		sem_post(&ctx->game_sync->player_turn[i]);
 	}
 }
 
-// Funcion auxiliar para manejar fin de juego
-static void handle_game_end(master_context_t *ctx) {
-	// Game ended - no more valid moves available
+void finish_game(master_context_t *ctx) {
+	// Fin de juego: no quedan movimientos validos o se alcanzo el timeout
 	ctx->game_state->game_finished = true;
+	live_stats_finish(ctx);
 	notify_all_players(ctx);
 }
 
 // Funcion auxiliar para sincronizar con view si es necesario
 static void sync_with_view_if_needed(master_context_t *ctx, bool movement_processed) {
 	if (movement_processed) {
+		unsigned long long span = trace_now(ctx->trace_ring);
 		sync_with_view(ctx);
+		trace_span(ctx->trace_ring, TRACE_VIEW_SYNC, span, TRACE_NO_ARG);
 		if (ctx->config.delay > 0) {
+			span = trace_now(ctx->trace_ring);
+			syscall_count(SYSCALL_USLEEP);
 			usleep(ctx->config.delay * 1000);
+			trace_span(ctx->trace_ring, TRACE_SLEEP, span, TRACE_NO_ARG);
 		}
 	}
 }
@@ -186,6 +393,8 @@ void game_loop(master_context_t *ctx) {
 	struct timeval timeout_tv;
 	time_t last_valid_move = time(NULL);
 	int current_player = 0;
+	round_t round;
+	memset(&round, 0, sizeof(round));
 
 	// arranca el juego
 
@@ -197,12 +406,15 @@ void game_loop(master_context_t *ctx) {
 
 	while (!ctx->game_state->game_finished) {
 		int max_fd;
-		setup_file_descriptors(ctx, &readfds, &max_fd);
+		setup_file_descriptors(ctx, &readfds, &max_fd, ctx->config.rounds ? &round : NULL);
 
 		timeout_tv.tv_sec = 1;
 		timeout_tv.tv_usec = 0;
 
+		unsigned long long span = trace_now(ctx->trace_ring);
+		syscall_count(SYSCALL_SELECT);
 		int ready = select(max_fd + 1, &readfds, NULL, NULL, &timeout_tv);
+		trace_span(ctx->trace_ring, TRACE_SELECT, span, TRACE_NO_ARG);
 
 		if (ready == -1) {
 			if (errno == EINTR)
@@ -219,11 +431,17 @@ void game_loop(master_context_t *ctx) {
 			continue;
 		}
 
-		bool movement_processed = process_player_moves(ctx, &readfds, &current_player, &last_valid_move);
+		// Con --rounds solo hay movimientos procesados (y sincronizacion con la vista) cuando se completa una ronda
+		bool movement_processed = ctx->config.rounds
+									  ? process_round_moves(ctx, &readfds, &round, &last_valid_move)
+									  : process_player_moves(ctx, &readfds, &current_player, &last_valid_move);
 
 		// Verificar fin de juego despues de procesar movimientos
-		if (check_game_end(ctx)) {
-			handle_game_end(ctx);
+		span = trace_now(ctx->trace_ring);
+		bool ended = check_game_end(ctx);
+		trace_span(ctx->trace_ring, TRACE_CHECK_END, span, TRACE_NO_ARG);
+		if (ended) {
+			finish_game(ctx);
 			break;
 		}
 
@@ -233,8 +451,7 @@ void game_loop(master_context_t *ctx) {
 		// Timeout global del juego
 		if (time(NULL) - last_valid_move > ctx->config.timeout) {
 			// Game timeout reached
-			ctx->game_state->game_finished = true;
-			notify_all_players(ctx);
+			finish_game(ctx);
 			break;
 		}
 	}
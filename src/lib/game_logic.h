@@ -2,6 +2,21 @@
 #define GAME_LOGIC_H
 
 #include "common.h"
+#include <time.h>
+
+// Movimiento recibido en una ronda (--rounds)
+typedef struct {
+	int player_id;					// ID del jugador
+	unsigned char move;				// Byte de movimiento recibido
+	unsigned long long received_ns; // Momento en que el master lo tomo
+} round_move_t;
+
+// Ronda en curso: un movimiento por jugador activo
+typedef struct {
+	round_move_t moves[MAX_PLAYERS]; // Movimientos en orden de llegada
+	bool submitted[MAX_PLAYERS];	 // Jugadores que ya movieron en la ronda
+	int count;						 // Cantidad de movimientos recibidos
+} round_t;
 
 /**
  * @brief Espera en un semaforo con timeout
@@ -19,6 +34,75 @@ int sem_wait_with_timeout(sem_t *sem, int timeout_sec);
  */
 void execute_player_move(master_context_t *ctx, int player_id, unsigned char direction);
 
+/**
+ * @brief Valida y aplica un movimiento recibido tomando el estado como escritor y devuelve el turno al jugador
+ * @param ctx Puntero al contexto del master
+ * @param player_id ID del jugador
+ * @param move Byte de movimiento recibido
+ * @param last_valid_move Momento del ultimo movimiento valido (se actualiza si el movimiento es valido)
+ */
+void apply_player_move(master_context_t *ctx, int player_id, unsigned char move, time_t *last_valid_move);
+
+/**
+ * @brief Agrega a la ronda el movimiento de un jugador
+ * @param round Ronda en curso
+ * @param player_id ID del jugador (no tiene que haber movido en la ronda)
+ * @param move Byte de movimiento recibido
+ */
+void round_add(round_t *round, int player_id, unsigned char move);
+
+/**
+ * @brief Indica si ya movieron todos los jugadores que no estan bloqueados
+ * @param ctx Puntero al contexto del master
+ * @param round Ronda en curso
+ * @return true si la ronda esta completa y tiene al menos un movimiento
+ */
+bool round_complete(const master_context_t *ctx, const round_t *round);
+
+/**
+ * @brief Aplica todos los movimientos de la ronda tomando el estado como escritor una sola vez
+ * @param ctx Puntero al contexto del master
+ * @param round Ronda completa (queda vacia para la siguiente)
+ * @param last_valid_move Momento del ultimo movimiento valido (se actualiza si algun movimiento es valido)
+ * @details Los movimientos se aplican en orden de puntaje al empezar la ronda (mayor primero) y despues de ID: si
+ * dos jugadores eligen la misma celda la toma el primero y el otro hace un movimiento invalido. Se graban en ese
+ * orden, asi que replay reproduce la partida. Al final se devuelve el turno a todos los que movieron.
+ */
+void apply_round(master_context_t *ctx, round_t *round, time_t *last_valid_move);
+
+/**
+ * @brief Espera a que todos los jugadores avisen players_ready (barrera de arranque)
+ * @param ctx Puntero al contexto del master (con start_time ya tomado)
+ * @param timeout_sec Espera maxima: los jugadores que no avisan (binarios sin la barrera) no la bloquean
+ * @return Cantidad de jugadores que avisaron
+ */
+int wait_players_ready(master_context_t *ctx, int timeout_sec);
+
+/**
+ * @brief Devuelve el turno a un jugador y registra el momento para medir la latencia del turno
+ * @param ctx Puntero al contexto del master
+ * @param player_id ID del jugador
+ */
+void grant_turn(master_context_t *ctx, int player_id);
+
+/**
+ * @brief Imprime los histogramas de latencia (turno, aplicacion del movimiento y vista)
+ * @param ctx Puntero al contexto del master
+ */
+void print_latency(const master_context_t *ctx);
+
+/**
+ * @brief Imprime los tiempos de arranque (barrera y primer movimiento) y del ultimo movimiento
+ * @param ctx Puntero al contexto del master
+ */
+void print_startup_times(const master_context_t *ctx);
+
+/**
+ * @brief Marca el juego como terminado y despierta a todos los jugadores
+ * @param ctx Puntero al contexto del master
+ */
+void finish_game(master_context_t *ctx);
+
 /**
  * @brief Verifica si el juego ha terminado
  * @param ctx Puntero al contexto del master
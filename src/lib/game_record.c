@@ -0,0 +1,138 @@
+// This is a personal academic project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: https://pvs-studio.com
+#include "game_record.h"
+#include "common.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define RECORD_BUFFER_SIZE (64 * 1024)
+
+int record_open(master_context_t *ctx) {
+	ctx->record_file = fopen(ctx->config.record_path, "wb");
+	if (ctx->record_file == NULL) {
+		perror("Error opening record file");
+		return -1;
+	}
+
+	// Buffer grande para que grabar un movimiento no implique un write por jugada
+	setvbuf(ctx->record_file, NULL, _IOFBF, RECORD_BUFFER_SIZE);
+
+	record_header_t header;
+	memset(&header, 0, sizeof(header));
+	header.magic = RECORD_MAGIC;
+	header.version = RECORD_VERSION;
+	header.seed = ctx->config.seed;
+	header.width = ctx->game_state->width;
+	header.height = ctx->game_state->height;
+	header.player_count = ctx->game_state->player_count;
+	for (unsigned int i = 0; i < header.player_count; i++) {
+		memcpy(header.names[i], ctx->game_state->players[i].name, MAX_NAME_LEN);
+	}
+
+	if (fwrite(&header, sizeof(header), 1, ctx->record_file) != 1) {
+		perror("Error writing record header");
+		fclose(ctx->record_file);
+		ctx->record_file = NULL;
+		return -1;
+	}
+
+	return 0;
+}
+
+void record_move(master_context_t *ctx, int player_id, unsigned char direction) {
+	if (ctx->record_file == NULL)
+		return;
+
+	record_move_t move = {(unsigned char) player_id, direction};
+	if (fwrite(&move, sizeof(move), 1, ctx->record_file) != 1) {
+		perror("Error writing record move");
+		fclose(ctx->record_file);
+		ctx->record_file = NULL;
+	}
+}
+
+void record_close(master_context_t *ctx) {
+	if (ctx->record_file == NULL)
+		return;
+
+	record_footer_t footer;
+	memset(&footer, 0, sizeof(footer));
+
+	long moves_bytes = ftell(ctx->record_file) - (long) sizeof(record_header_t);
+	footer.move_count = (unsigned int) (moves_bytes / (long) sizeof(record_move_t));
+	for (unsigned int i = 0; i < ctx->game_state->player_count; i++) {
+		footer.scores[i] = ctx->game_state->players[i].score;
+		footer.valid_moves[i] = ctx->game_state->players[i].valid_moves;
+		footer.invalid_moves[i] = ctx->game_state->players[i].invalid_moves;
+	}
+
+	if (fwrite(&footer, sizeof(footer), 1, ctx->record_file) != 1) {
+		perror("Error writing record footer");
+	}
+
+	fclose(ctx->record_file);
+	ctx->record_file = NULL;
+}
+
+int record_load(const char *path, game_record_t *record) {
+	memset(record, 0, sizeof(*record));
+
+	FILE *file = fopen(path, "rb");
+	if (file == NULL) {
+		perror("Error opening record file");
+		return -1;
+	}
+
+	if (fread(&record->header, sizeof(record_header_t), 1, file) != 1 || record->header.magic != RECORD_MAGIC ||
+		record->header.version != RECORD_VERSION) {
+		fprintf(stderr, "Error: %s is not a valid game record\n", path);
+		fclose(file);
+		return -1;
+	}
+
+	if (record->header.player_count == 0 || record->header.player_count > MAX_PLAYERS) {
+		fprintf(stderr, "Error: %s has an invalid player count\n", path);
+		fclose(file);
+		return -1;
+	}
+
+	// Los movimientos ocupan todo lo que hay entre el encabezado y el resultado final
+	if (fseek(file, 0, SEEK_END) != 0) {
+		perror("Error seeking record file");
+		fclose(file);
+		return -1;
+	}
+	long moves_bytes = ftell(file) - (long) sizeof(record_header_t) - (long) sizeof(record_footer_t);
+	if (moves_bytes < 0 || moves_bytes % (long) sizeof(record_move_t) != 0) {
+		fprintf(stderr, "Error: %s is truncated\n", path);
+		fclose(file);
+		return -1;
+	}
+	record->move_count = (unsigned int) (moves_bytes / (long) sizeof(record_move_t));
+
+	record->moves = malloc(record->move_count * sizeof(record_move_t) + 1);
+	if (record->moves == NULL) {
+		perror("Error allocating memory for record moves");
+		fclose(file);
+		return -1;
+	}
+
+	if (fseek(file, (long) sizeof(record_header_t), SEEK_SET) != 0 ||
+		fread(record->moves, sizeof(record_move_t), record->move_count, file) != record->move_count ||
+		fread(&record->footer, sizeof(record_footer_t), 1, file) != 1) {
+		fprintf(stderr, "Error: could not read %s\n", path);
+		record_free(record);
+		fclose(file);
+		return -1;
+	}
+
+	fclose(file);
+	return 0;
+}
+
+void record_free(game_record_t *record) {
+	free(record->moves);
+	record->moves = NULL;
+	record->move_count = 0;
+}
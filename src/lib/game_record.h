@@ -0,0 +1,77 @@
+#ifndef GAME_RECORD_H
+#define GAME_RECORD_H
+
+#include "common.h"
+
+#define RECORD_MAGIC 0x504d4843 // "CHMP" en little endian
+#define RECORD_VERSION 1
+
+// Encabezado de una partida grabada (todo lo necesario para regenerar el tablero)
+typedef struct {
+	unsigned int magic;					   // Identificador del formato
+	unsigned int version;				   // Version del formato
+	unsigned int seed;					   // Semilla usada por initialize_game_state
+	unsigned short width;				   // Ancho del tablero
+	unsigned short height;				   // Alto del tablero
+	unsigned int player_count;			   // Cantidad de jugadores
+	char names[MAX_PLAYERS][MAX_NAME_LEN]; // Nombres de los jugadores
+} record_header_t;
+
+// Movimiento procesado por el master (valido o invalido)
+typedef struct {
+	unsigned char player_id; // ID del jugador
+	unsigned char direction; // Byte recibido por el pipe
+} record_move_t;
+
+// Resultado final de la partida grabada
+typedef struct {
+	unsigned int move_count;				// Cantidad de movimientos grabados
+	unsigned int scores[MAX_PLAYERS];		// Puntaje final de cada jugador
+	unsigned int valid_moves[MAX_PLAYERS];	// Movimientos validos de cada jugador
+	unsigned int invalid_moves[MAX_PLAYERS]; // Movimientos invalidos de cada jugador
+} record_footer_t;
+
+// Partida grabada cargada en memoria
+typedef struct {
+	record_header_t header; // Encabezado
+	record_move_t *moves;	// Movimientos en orden de procesamiento
+	unsigned int move_count; // Cantidad de movimientos
+	record_footer_t footer; // Resultado final
+} game_record_t;
+
+/**
+ * @brief Abre el archivo de grabacion y escribe el encabezado de la partida
+ * @param ctx Puntero al contexto del master (con el estado ya inicializado)
+ * @return 0 si se pudo abrir, -1 en caso de error
+ */
+int record_open(master_context_t *ctx);
+
+/**
+ * @brief Graba un movimiento procesado por el master
+ * @param ctx Puntero al contexto del master
+ * @param player_id ID del jugador
+ * @param direction Byte de movimiento recibido
+ */
+void record_move(master_context_t *ctx, int player_id, unsigned char direction);
+
+/**
+ * @brief Escribe el resultado final y cierra el archivo de grabacion
+ * @param ctx Puntero al contexto del master
+ */
+void record_close(master_context_t *ctx);
+
+/**
+ * @brief Carga una partida grabada completa en memoria
+ * @param path Ruta del archivo de grabacion
+ * @param record Puntero a la partida a llenar
+ * @return 0 si la carga fue exitosa, -1 en caso de error
+ */
+int record_load(const char *path, game_record_t *record);
+
+/**
+ * @brief Libera la memoria de una partida cargada
+ * @param record Puntero a la partida
+ */
+void record_free(game_record_t *record);
+
+#endif // GAME_RECORD_H
@@ -0,0 +1,86 @@
+// This is a personal academic project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: https://pvs-studio.com
+#include "histogram.h"
+#include <stdbool.h>
+
+/**
+ * @brief Indice del bucket de un valor
+ * @details Los valores menores a HISTOGRAM_SUB_BUCKETS tienen un bucket cada uno; el resto se ubica por su bit mas
+ * significativo (grupo) y los HISTOGRAM_SUB_BITS bits siguientes (bucket dentro del grupo)
+ */
+static int bucket_index(unsigned long long value) {
+	if (value < HISTOGRAM_SUB_BUCKETS)
+		return (int) value;
+
+	int exponent = 63 - __builtin_clzll(value);
+	if (exponent >= HISTOGRAM_MAX_BITS)
+		return HISTOGRAM_BUCKETS - 1;
+
+	int group = exponent - HISTOGRAM_SUB_BITS + 1;
+	int sub = (int) ((value >> (exponent - HISTOGRAM_SUB_BITS)) & (HISTOGRAM_SUB_BUCKETS - 1));
+	return group * HISTOGRAM_SUB_BUCKETS + sub;
+}
+
+/**
+ * @brief Mayor valor que cae en un bucket
+ */
+static unsigned long long bucket_upper(int index) {
+	int group = index / HISTOGRAM_SUB_BUCKETS;
+	unsigned long long sub = (unsigned long long) (index % HISTOGRAM_SUB_BUCKETS);
+	if (group == 0)
+		return sub;
+
+	unsigned long long lower = (HISTOGRAM_SUB_BUCKETS + sub) << (group - 1);
+	return lower + (1ULL << (group - 1)) - 1;
+}
+
+void histogram_record(histogram_t *histogram, unsigned long long value) {
+	__atomic_fetch_add(&histogram->counts[bucket_index(value)], 1, __ATOMIC_RELAXED);
+	__atomic_fetch_add(&histogram->sum, value, __ATOMIC_RELAXED);
+	__atomic_fetch_add(&histogram->count, 1, __ATOMIC_RELAXED);
+
+	unsigned long long max = __atomic_load_n(&histogram->max, __ATOMIC_RELAXED);
+	while (value > max &&
+		   !__atomic_compare_exchange_n(&histogram->max, &max, value, false, __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+	}
+}
+
+void histogram_merge(histogram_t *into, const histogram_t *from) {
+	for (int i = 0; i < HISTOGRAM_BUCKETS; i++) {
+		into->counts[i] += from->counts[i];
+	}
+	into->count += from->count;
+	into->sum += from->sum;
+	if (from->max > into->max) {
+		into->max = from->max;
+	}
+}
+
+unsigned long long histogram_percentile(const histogram_t *histogram, double percentile) {
+	unsigned long long count = __atomic_load_n(&histogram->count, __ATOMIC_RELAXED);
+	if (count == 0)
+		return 0;
+
+	// Rango (1..count) del valor buscado
+	unsigned long long rank = (unsigned long long) (percentile / 100.0 * count + 0.5);
+	rank = (rank < 1) ? 1 : (rank > count ? count : rank);
+
+	unsigned long long max = __atomic_load_n(&histogram->max, __ATOMIC_RELAXED);
+	unsigned long long seen = 0;
+	for (int i = 0; i < HISTOGRAM_BUCKETS; i++) {
+		seen += __atomic_load_n(&histogram->counts[i], __ATOMIC_RELAXED);
+		if (seen >= rank) {
+			unsigned long long upper = bucket_upper(i);
+			return upper < max ? upper : max;
+		}
+	}
+	return max;
+}
+
+void histogram_print(FILE *out, const char *name, const histogram_t *histogram) {
+	unsigned long long count = histogram->count;
+	double average = count > 0 ? (double) histogram->sum / count : 0.0;
+	fprintf(out, "%-12s %8llu %10.1f %10.1f %10.1f %10.1f %10.1f\n", name, count, average / 1000.0,
+			histogram_percentile(histogram, 50) / 1000.0, histogram_percentile(histogram, 90) / 1000.0,
+			histogram_percentile(histogram, 99) / 1000.0, histogram->max / 1000.0);
+}
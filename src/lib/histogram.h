@@ -0,0 +1,57 @@
+#ifndef HISTOGRAM_H
+#define HISTOGRAM_H
+
+#include <stdio.h>
+
+/*
+ * Histograma log-lineal de latencias (en nanosegundos).
+ *
+ * Cada potencia de dos se divide en HISTOGRAM_SUB_BUCKETS buckets lineales, asi el error relativo de un percentil
+ * queda acotado (1/16 = 6%) para cualquier magnitud, desde nanosegundos hasta minutos, con un arreglo fijo.
+ * Registrar un valor es calcular un indice y hacer un incremento atomico: no reserva memoria ni toma locks, y se
+ * puede leer mientras se escribe (los percentiles de una lectura concurrente pueden estar atrasados un valor).
+ */
+
+#define HISTOGRAM_SUB_BITS 4
+#define HISTOGRAM_SUB_BUCKETS (1 << HISTOGRAM_SUB_BITS)
+#define HISTOGRAM_MAX_BITS 40 // Valores de hasta 2^40 ns (~18 minutos); los mayores van al ultimo bucket
+#define HISTOGRAM_BUCKETS ((HISTOGRAM_MAX_BITS - HISTOGRAM_SUB_BITS + 1) * HISTOGRAM_SUB_BUCKETS)
+
+typedef struct {
+	unsigned long long counts[HISTOGRAM_BUCKETS]; // Valores en cada bucket
+	unsigned long long count;					  // Cantidad de valores
+	unsigned long long sum;						  // Suma de los valores
+	unsigned long long max;						  // Valor maximo
+} histogram_t;
+
+/**
+ * @brief Registra un valor
+ * @param histogram Histograma
+ * @param value Valor en nanosegundos
+ */
+void histogram_record(histogram_t *histogram, unsigned long long value);
+
+/**
+ * @brief Suma los valores de un histograma a otro
+ * @param into Histograma acumulado
+ * @param from Histograma a sumar
+ */
+void histogram_merge(histogram_t *into, const histogram_t *from);
+
+/**
+ * @brief Calcula un percentil
+ * @param histogram Histograma
+ * @param percentile Percentil entre 0 y 100
+ * @return Cota superior del bucket que contiene el percentil (acotada por el maximo), 0 si esta vacio
+ */
+unsigned long long histogram_percentile(const histogram_t *histogram, double percentile);
+
+/**
+ * @brief Imprime una linea con cantidad, promedio, p50, p90, p99 y maximo en microsegundos
+ * @param out Stream de salida
+ * @param name Nombre de la medicion
+ * @param histogram Histograma
+ */
+void histogram_print(FILE *out, const char *name, const histogram_t *histogram);
+
+#endif // HISTOGRAM_H
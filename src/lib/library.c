@@ -2,10 +2,13 @@
 // PVS-Studio Static Code Analyzer for C, C++, C#, and Java: https://pvs-studio.com
 #include "library.h"
 #include "common.h"
+#include "engine.h"
 #include <fcntl.h>
+#include <limits.h>
 #include <signal.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <sys/mman.h>
 #include <unistd.h>
 
@@ -14,18 +17,7 @@ int *get_cell(game_state_t *state, int x, int y) {
 }
 
 void get_direction_offset(direction_t dir, int *dx, int *dy) {
-	static const int offsets[][2] = {
-		{0, -1}, // UP
-		{1, -1}, // UP_RIGHT
-		{1, 0},	 // RIGHT
-		{1, 1},	 // DOWN_RIGHT
-		{0, 1},	 // DOWN
-		{-1, 1}, // DOWN_LEFT
-		{-1, 0}, // LEFT
-		{-1, -1} // UP_LEFT
-	};
-	*dx = offsets[dir][0];
-	*dy = offsets[dir][1];
+	engine_direction_offset(dir, dx, dy);
 }
 
 const char *get_player_color(int player_id) {
@@ -78,12 +70,39 @@ void clean_buffer(void) {
 }
 
 void check_params(int argc, char *argv[]) {
-	if (argc != 3 || (atoi(argv[1]) <= 0 || atoi(argv[2]) <= 0)) {
+	// El tercer parametro opcional es la estrategia del jugador
+	if ((argc != 3 && argc != 4) || (atoi(argv[1]) <= 0 || atoi(argv[2]) <= 0)) {
 		fprintf(stderr, "Error with params");
 		exit(EXIT_FAILURE);
 	}
 }
 
+const char *split_player_spec(const char *spec, char *binary, size_t binary_size) {
+	const char *separator = strrchr(spec, ':');
+	size_t length = (separator != NULL) ? (size_t) (separator - spec) : strlen(spec);
+	if (length >= binary_size) {
+		length = binary_size - 1;
+	}
+
+	memcpy(binary, spec, length);
+	binary[length] = '\0';
+
+	return (separator != NULL && separator[1] != '\0') ? separator + 1 : NULL;
+}
+
+const char *shm_name(const char *base) {
+	static __thread char names[SHM_NAME_BUFFERS][NAME_MAX];
+	static __thread unsigned int next;
+
+	const char *namespace = getenv(SHM_NAMESPACE_ENV);
+	if (namespace == NULL || namespace[0] == '\0' || strchr(namespace, '/') != NULL)
+		return base;
+
+	char *name = names[next++ % SHM_NAME_BUFFERS];
+	snprintf(name, NAME_MAX, "%s_%s", base, namespace);
+	return name;
+}
+
 void close_up(int *sync_fd, int *state_fd, game_state_t **game_state, game_sync_t **game_sync) {
 	if (*game_state != NULL && *game_state != MAP_FAILED) {
 		munmap(*game_state, sizeof(game_state_t) + (*game_state)->width * (*game_state)->height * sizeof(int));
@@ -105,7 +124,7 @@ void close_up(int *sync_fd, int *state_fd, game_state_t **game_state, game_sync_
 int connect_shared_memories(int game_state_size, int game_sync_size, int *sync_fd, int *state_fd,
 							game_state_t **game_state, game_sync_t **game_sync) {
 	// Abrir la memoria compartida para el estado del juego
-	*state_fd = shm_open(GAME_STATE_SHM, O_RDONLY, 0);
+	*state_fd = shm_open(shm_name(GAME_STATE_SHM), O_RDONLY, 0);
 	if (*state_fd == -1) {
 		perror("Error opening shared memory (state)");
 		return -1;
@@ -120,7 +139,7 @@ int connect_shared_memories(int game_state_size, int game_sync_size, int *sync_f
 	}
 
 	// Abrir la memoria compartida para sincronizacion
-	*sync_fd = shm_open(GAME_SYNC_SHM, O_RDWR, 0);
+	*sync_fd = shm_open(shm_name(GAME_SYNC_SHM), O_RDWR, 0);
 	if (*sync_fd == -1) {
 		perror("Error opening shared memory (sync)");
 		munmap(*game_state, game_state_size);
@@ -141,21 +160,8 @@ int connect_shared_memories(int game_state_size, int game_sync_size, int *sync_f
 	return 0;
 }
 
-bool is_valid_move(int player_id, direction_t direction, game_state_t *game_state) {
-	player_t *player = &game_state->players[player_id];
-	int dx, dy;
-
-	// Futura posicion del player
-	get_direction_offset(direction, &dx, &dy);
-	int new_x = player->x + dx;
-	int new_y = player->y + dy;
-
-	// Validacion de que la nueva posicion este dentro del tablero
-	if (new_x < 0 || new_y < 0 || new_x >= game_state->width || new_y >= game_state->height) {
-		return false;
-	}
-
-	// Validar que no este ocupado
-	int *cell = get_cell(game_state, new_x, new_y);
-	return (*cell > 0);
+bool is_valid_move(int player_id, direction_t direction, const game_state_t *game_state) {
+	const player_t *player = &game_state->players[player_id];
+	return engine_target(game_state->board, game_state->width, game_state->height, player->x, player->y, direction,
+						 NULL, NULL);
 }
\ No newline at end of file
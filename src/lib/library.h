@@ -15,6 +15,7 @@
 #define COLOR_PLAYER_8 "\033[1;90m"		 // Gris brillante
 #define COLOR_PLAYER_9 "\033[1;38;5;94m" // Marron brillante
 #define COLOR_RESET "\033[0m"
+#define SHM_NAME_BUFFERS 4 // Llamadas a shm_name que pueden usarse a la vez
 
 /**
  * @brief Obtiene el color correspondiente a un jugador
@@ -50,6 +51,25 @@ void setup_standard_signals(void (*signal_handler)(int));
  */
 void check_params(int argc, char *argv[]);
 
+/**
+ * @brief Separa una especificacion de jugador de la forma "binario[:estrategia]"
+ * @param spec Especificacion pasada con -p
+ * @param binary Buffer donde copiar la ruta del binario
+ * @param binary_size Tamaño del buffer
+ * @return Puntero a la estrategia dentro de spec, o NULL si no se especifico
+ */
+const char *split_player_spec(const char *spec, char *binary, size_t binary_size);
+
+/**
+ * @brief Nombre de un segmento de memoria compartida en el espacio de nombres de la partida
+ * @param base Nombre base (por ejemplo GAME_STATE_SHM)
+ * @return base, o base + "_" + $CHOMP_SHM_NAMESPACE si esta definida
+ * @details Los hijos heredan el entorno del master, asi que todos los procesos de una partida resuelven los mismos
+ * nombres y varias partidas con distinto espacio de nombres pueden correr a la vez. El resultado vive en un buffer
+ * estatico que se reutiliza cada SHM_NAME_BUFFERS llamadas del mismo thread: hay que usarlo enseguida.
+ */
+const char *shm_name(const char *base);
+
 /**
  * @brief Cierra y desmapea las memorias compartidas.
  * @param sync_fd Puntero al descriptor de archivo de la memoria compartida de sincronizacion.
@@ -107,7 +127,7 @@ int *get_cell(game_state_t *state, int x, int y);
  * @param game_state Estado del juego
  * @return true si el movimiento es valido, false en caso contrario
  */
-bool is_valid_move(int player_id, direction_t direction, game_state_t *game_state);
+bool is_valid_move(int player_id, direction_t direction, const game_state_t *game_state);
 /**
  * @brief Obtiene el desplazamiento en x e y segun la direccion
  * @param dir Direccion del movimiento
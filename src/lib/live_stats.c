@@ -0,0 +1,98 @@
+// This is a personal academic project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: https://pvs-studio.com
+#define _GNU_SOURCE
+#include "live_stats.h"
+#include "library.h"
+#include <fcntl.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+int live_stats_create(master_context_t *ctx) {
+	int fd = shm_open(shm_name(GAME_LIVE_STATS_SHM), O_CREAT | O_RDWR | O_EXCL, 0644);
+	if (fd == -1) {
+		perror("Error creating live stats shared memory");
+		return -1;
+	}
+	if (ftruncate(fd, sizeof(game_live_stats_t)) == -1) {
+		perror("Error setting live stats size");
+		close(fd);
+		shm_unlink(shm_name(GAME_LIVE_STATS_SHM));
+		return -1;
+	}
+
+	game_live_stats_t *stats = mmap(NULL, sizeof(game_live_stats_t), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+	close(fd);
+	if (stats == MAP_FAILED) {
+		perror("Error mapping live stats");
+		shm_unlink(shm_name(GAME_LIVE_STATS_SHM));
+		return -1;
+	}
+
+	// Campos fijos: se escriben antes de que cualquier lector pueda ver contadores
+	struct timespec now;
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	stats->master_pid = getpid();
+	stats->player_count = (unsigned int) ctx->config.player_count;
+	stats->timeout = (unsigned int) ctx->config.timeout;
+	for (int i = 0; i < ctx->config.player_count; i++) {
+		memcpy(stats->names[i], ctx->game_state->players[i].name, MAX_NAME_LEN);
+	}
+	stats->start_ns = (unsigned long long) now.tv_sec * 1000000000ULL + (unsigned long long) now.tv_nsec;
+	__atomic_store_n(&stats->last_valid_move, (long long) time(NULL), __ATOMIC_RELEASE);
+
+	ctx->live_stats = stats;
+	return 0;
+}
+
+void live_stats_move(master_context_t *ctx, int player_id, bool valid, time_t last_valid_move,
+					 unsigned long long lock_wait_ns) {
+	game_live_stats_t *stats = ctx->live_stats;
+	if (stats == NULL)
+		return;
+
+	__atomic_fetch_add(&stats->moves[player_id], 1, __ATOMIC_RELAXED);
+	if (valid) {
+		__atomic_store_n(&stats->score[player_id], ctx->game_state->players[player_id].score, __ATOMIC_RELAXED);
+		__atomic_store_n(&stats->last_valid_move, (long long) last_valid_move, __ATOMIC_RELAXED);
+	}
+	else {
+		__atomic_fetch_add(&stats->invalid[player_id], 1, __ATOMIC_RELAXED);
+	}
+	__atomic_fetch_add(&stats->lock_wait_ns, lock_wait_ns, __ATOMIC_RELAXED);
+	__atomic_fetch_add(&stats->tick, 1, __ATOMIC_RELAXED);
+}
+
+void live_stats_frame(master_context_t *ctx) {
+	if (ctx->live_stats != NULL) {
+		__atomic_fetch_add(&ctx->live_stats->view_frames, 1, __ATOMIC_RELAXED);
+	}
+}
+
+void live_stats_finish(master_context_t *ctx) {
+	if (ctx->live_stats != NULL) {
+		__atomic_store_n(&ctx->live_stats->finished, 1, __ATOMIC_RELEASE);
+	}
+}
+
+void live_stats_destroy(master_context_t *ctx) {
+	if (ctx->live_stats == NULL)
+		return;
+
+	// Un chompstat conectado conserva su mapeo y ve la partida terminada
+	live_stats_finish(ctx);
+	munmap(ctx->live_stats, sizeof(game_live_stats_t));
+	shm_unlink(shm_name(GAME_LIVE_STATS_SHM));
+	ctx->live_stats = NULL;
+}
+
+const game_live_stats_t *live_stats_connect(void) {
+	int fd = shm_open(shm_name(GAME_LIVE_STATS_SHM), O_RDONLY, 0);
+	if (fd == -1)
+		return NULL;
+
+	const game_live_stats_t *stats = mmap(NULL, sizeof(game_live_stats_t), PROT_READ, MAP_SHARED, fd, 0);
+	close(fd);
+	return (stats == MAP_FAILED) ? NULL : stats;
+}
@@ -0,0 +1,76 @@
+#ifndef LIVE_STATS_H
+#define LIVE_STATS_H
+
+#include "common.h"
+#include <time.h>
+
+/*
+ * Estadisticas en vivo de la partida (--live-stats), para seguir partidas largas sin vista con chompstat.
+ *
+ * El master es el unico escritor del segmento GAME_LIVE_STATS_SHM: cada contador se actualiza con una operacion
+ * atomica relajada y los lectores (chompstat) lo mapean de solo lectura y leen cada campo con una carga atomica.
+ * No hay semaforos ni secuencias: un lector puede ver contadores de ticks distintos, pero nunca un valor a medias,
+ * y no puede demorar al master.
+ */
+
+#define GAME_LIVE_STATS_SHM "/game_live_stats"
+
+typedef struct game_live_stats {
+	pid_t master_pid;						 // Proceso que publica el segmento
+	unsigned int player_count;				 // Cantidad de jugadores
+	unsigned int timeout;					 // Timeout de la partida (s)
+	char names[MAX_PLAYERS][MAX_NAME_LEN];	 // Nombre de cada jugador
+	unsigned long long start_ns;			 // Creacion del segmento (CLOCK_MONOTONIC)
+	unsigned long long tick;				 // Movimientos procesados
+	unsigned long long moves[MAX_PLAYERS];	 // Movimientos procesados de cada jugador
+	unsigned long long invalid[MAX_PLAYERS]; // Movimientos invalidos de cada jugador
+	unsigned long long score[MAX_PLAYERS];	 // Puntaje de cada jugador
+	unsigned long long view_frames;			 // Sincronizaciones completas con la vista
+	unsigned long long lock_wait_ns;		 // Espera total del master por el lock de escritura
+	long long last_valid_move;				 // Momento del ultimo movimiento valido (time(NULL), el de check_timeout)
+	unsigned int finished;					 // 1 cuando la partida termino
+} game_live_stats_t;
+
+/**
+ * @brief Crea el segmento de estadisticas en vivo (despues de initialize_game_state)
+ * @param ctx Puntero al contexto del master
+ * @return 0 si la creacion fue exitosa, -1 en caso de error
+ */
+int live_stats_create(master_context_t *ctx);
+
+/**
+ * @brief Registra un movimiento procesado (no hace nada sin --live-stats)
+ * @param ctx Puntero al contexto del master
+ * @param player_id ID del jugador
+ * @param valid Si el movimiento fue valido
+ * @param last_valid_move Momento del ultimo movimiento valido
+ * @param lock_wait_ns Espera del master por el lock de escritura en este movimiento
+ */
+void live_stats_move(master_context_t *ctx, int player_id, bool valid, time_t last_valid_move,
+					 unsigned long long lock_wait_ns);
+
+/**
+ * @brief Registra una sincronizacion completa con la vista
+ * @param ctx Puntero al contexto del master
+ */
+void live_stats_frame(master_context_t *ctx);
+
+/**
+ * @brief Marca la partida como terminada
+ * @param ctx Puntero al contexto del master
+ */
+void live_stats_finish(master_context_t *ctx);
+
+/**
+ * @brief Libera y desvincula el segmento
+ * @param ctx Puntero al contexto del master
+ */
+void live_stats_destroy(master_context_t *ctx);
+
+/**
+ * @brief Mapea el segmento de solo lectura (chompstat)
+ * @return Segmento, o NULL si no hay una partida publicando estadisticas
+ */
+const game_live_stats_t *live_stats_connect(void);
+
+#endif // LIVE_STATS_H
@@ -0,0 +1,159 @@
+// This is a personal academic project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: https://pvs-studio.com
+#define _GNU_SOURCE
+#include "lock_stats.h"
+#include "library.h"
+#include "syscall_stats.h"
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <time.h>
+#include <unistd.h>
+
+static const char *lock_names[LOCK_COUNT] = {"reader_writer", "state", "reader_count"};
+
+static unsigned long long now_ns(void) {
+	struct timespec now;
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return (unsigned long long) now.tv_sec * 1000000000ULL + (unsigned long long) now.tv_nsec;
+}
+
+void lock_enter(lock_slot_t *slot, lock_id_t lock, sem_t *sem) {
+	if (slot == NULL) {
+		if (sem != NULL) {
+			syscall_count(SYSCALL_SEM_WAIT);
+			sem_wait(sem);
+		}
+		return;
+	}
+
+	lock_counter_t *counter = &slot->locks[lock];
+	unsigned long long start = now_ns();
+	// Cuenta como el sem_wait de siempre: el sem_trywait solo distingue si hubo contencion, y asi --lock-stats no
+	// cambia la tabla de --syscalls
+	if (sem != NULL) {
+		syscall_count(SYSCALL_SEM_WAIT);
+		if (sem_trywait(sem) != 0) {
+			sem_wait(sem);
+			counter->contended++;
+		}
+	}
+	unsigned long long acquired = now_ns();
+
+	counter->acquisitions++;
+	counter->wait_ns += acquired - start;
+	if (acquired - start > counter->max_wait_ns) {
+		counter->max_wait_ns = acquired - start;
+	}
+	counter->acquired_ns = acquired;
+}
+
+void lock_exit(lock_slot_t *slot, lock_id_t lock, sem_t *sem) {
+	if (slot != NULL && slot->locks[lock].acquired_ns != 0) {
+		lock_counter_t *counter = &slot->locks[lock];
+		unsigned long long held = now_ns() - counter->acquired_ns;
+		counter->hold_ns += held;
+		if (held > counter->max_hold_ns) {
+			counter->max_hold_ns = held;
+		}
+		counter->acquired_ns = 0;
+	}
+	if (sem != NULL) {
+		syscall_count(SYSCALL_SEM_POST);
+		sem_post(sem);
+	}
+}
+
+int lock_stats_create(game_lock_stats_t **stats, bool shared) {
+	if (!shared) {
+		*stats = calloc(1, sizeof(game_lock_stats_t));
+		return *stats == NULL ? -1 : 0;
+	}
+
+	int fd = shm_open(shm_name(LOCK_STATS_SHM), O_CREAT | O_RDWR | O_EXCL, 0666);
+	if (fd == -1) {
+		perror("Error creating lock stats shared memory");
+		return -1;
+	}
+	if (ftruncate(fd, sizeof(game_lock_stats_t)) == -1) {
+		perror("Error setting lock stats size");
+		close(fd);
+		shm_unlink(shm_name(LOCK_STATS_SHM));
+		return -1;
+	}
+
+	*stats = mmap(NULL, sizeof(game_lock_stats_t), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+	close(fd);
+	if (*stats == MAP_FAILED) {
+		perror("Error mapping lock stats");
+		*stats = NULL;
+		shm_unlink(shm_name(LOCK_STATS_SHM));
+		return -1;
+	}
+	return 0;
+}
+
+void lock_stats_destroy(game_lock_stats_t **stats, bool shared) {
+	if (*stats == NULL)
+		return;
+
+	if (shared) {
+		munmap(*stats, sizeof(game_lock_stats_t));
+		shm_unlink(shm_name(LOCK_STATS_SHM));
+	}
+	else {
+		free(*stats);
+	}
+	*stats = NULL;
+}
+
+lock_slot_t *lock_stats_connect(int player_id) {
+	int fd = shm_open(shm_name(LOCK_STATS_SHM), O_RDWR, 0);
+	if (fd == -1)
+		return NULL;
+
+	// El mapeo se mantiene hasta que el jugador termina
+	game_lock_stats_t *stats = mmap(NULL, sizeof(game_lock_stats_t), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+	close(fd);
+	if (stats == MAP_FAILED)
+		return NULL;
+
+	lock_slot_t *slot = &stats->slots[player_id + 1];
+	slot->pid = getpid();
+	return slot;
+}
+
+void lock_stats_print(const game_lock_stats_t *stats, int player_count) {
+	printf("\n=== LOCK STATS (us) ===\n");
+	printf("%-8s %-14s %10s %9s %10s %10s %10s %10s\n", "Process", "Lock", "Acquired", "Contended", "Avg wait",
+		   "Max wait", "Avg hold", "Max hold");
+
+	for (int i = 0; i <= player_count && i < LOCK_STATS_SLOTS; i++) {
+		char name[16];
+		if (i == LOCK_STATS_MASTER) {
+			snprintf(name, sizeof(name), "master");
+		}
+		else {
+			snprintf(name, sizeof(name), "P%d", i);
+		}
+
+		for (int lock = 0; lock < LOCK_COUNT; lock++) {
+			const lock_counter_t *counter = &stats->slots[i].locks[lock];
+			if (counter->acquisitions == 0)
+				continue;
+			printf("%-8s %-14s %10llu %8.1f%% %10.2f %10.1f %10.2f %10.1f\n", name, lock_names[lock],
+				   counter->acquisitions, 100.0 * counter->contended / counter->acquisitions,
+				   counter->wait_ns / 1000.0 / counter->acquisitions, counter->max_wait_ns / 1000.0,
+				   counter->hold_ns / 1000.0 / counter->acquisitions, counter->max_hold_ns / 1000.0);
+		}
+	}
+
+	// Cuanto espera el master para escribir mientras los lectores tienen el estado
+	const histogram_t *wait = &stats->writer_wait;
+	printf("Writer starvation: %llu writes, waited p50 %.1f us, p99 %.1f us, max %.1f us, total %.1f ms\n",
+		   wait->count, histogram_percentile(wait, 50) / 1000.0, histogram_percentile(wait, 99) / 1000.0,
+		   wait->max / 1000.0, wait->sum / 1000000.0);
+	printf("=======================\n");
+}
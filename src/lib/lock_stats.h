@@ -0,0 +1,98 @@
+#ifndef LOCK_STATS_H
+#define LOCK_STATS_H
+
+#include "common.h"
+#include "histogram.h"
+
+/*
+ * Instrumentacion de los locks del protocolo lectores-escritores (--lock-stats).
+ *
+ * El master crea el segmento LOCK_STATS_SHM con un lugar por proceso (0 el master, 1..9 los jugadores). Cada
+ * proceso escribe solo en su lugar, asi que no hace falta sincronizar: por cada lock se cuentan adquisiciones,
+ * adquisiciones con espera, tiempo total y maximo de espera y de retencion. Para state_mutex los lectores cuentan
+ * su seccion de lectura completa como retencion (el lock lo toma el primer lector y lo libera el ultimo).
+ *
+ * Con lugar NULL (sin --lock-stats, o un master que no crea el segmento) las funciones solo hacen sem_wait/sem_post.
+ */
+
+#define LOCK_STATS_SHM "/game_lock_stats"
+#define LOCK_STATS_SLOTS (MAX_PLAYERS + 1) // Master y jugadores
+#define LOCK_STATS_MASTER 0
+
+typedef enum {
+	LOCK_READER_WRITER = 0, // reader_writer_mutex (C)
+	LOCK_STATE,				// state_mutex (D)
+	LOCK_READER_COUNT,		// reader_count_mutex (E)
+	LOCK_COUNT
+} lock_id_t;
+
+// Contadores de un lock en un proceso
+typedef struct {
+	unsigned long long acquisitions; // Adquisiciones
+	unsigned long long contended;	 // Adquisiciones que tuvieron que esperar
+	unsigned long long wait_ns;		 // Tiempo total de espera
+	unsigned long long max_wait_ns;	 // Espera mas larga
+	unsigned long long hold_ns;		 // Tiempo total de retencion
+	unsigned long long max_hold_ns;	 // Retencion mas larga
+	unsigned long long acquired_ns;	 // Momento de la ultima adquisicion (0 si no esta tomado)
+} lock_counter_t;
+
+// Lugar de un proceso
+typedef struct lock_slot {
+	pid_t pid;						// Proceso que usa el lugar (0 si no se uso)
+	lock_counter_t locks[LOCK_COUNT]; // Contadores por lock
+} lock_slot_t;
+
+// Segmento compartido
+typedef struct game_lock_stats {
+	lock_slot_t slots[LOCK_STATS_SLOTS]; // Lugar de cada proceso
+	histogram_t writer_wait;			 // Espera del master para entrar como escritor (C + D)
+} game_lock_stats_t;
+
+/**
+ * @brief Toma un lock y registra la espera
+ * @param slot Lugar del proceso (NULL: sin instrumentar)
+ * @param lock Lock que se toma
+ * @param sem Semaforo a esperar, o NULL si solo se registra una adquisicion logica (lector que entra cuando otro
+ * lector ya tiene state_mutex)
+ */
+void lock_enter(lock_slot_t *slot, lock_id_t lock, sem_t *sem);
+
+/**
+ * @brief Libera un lock y registra la retencion
+ * @param slot Lugar del proceso (NULL: sin instrumentar)
+ * @param lock Lock que se libera
+ * @param sem Semaforo a liberar, o NULL si otro proceso lo libera (lector que no es el ultimo)
+ */
+void lock_exit(lock_slot_t *slot, lock_id_t lock, sem_t *sem);
+
+/**
+ * @brief Crea el segmento de estadisticas (master)
+ * @param stats Puntero para almacenar el segmento
+ * @param shared true para crearlo en memoria compartida, false para memoria privada (--threads)
+ * @return 0 si la creacion fue exitosa, -1 en caso de error
+ */
+int lock_stats_create(game_lock_stats_t **stats, bool shared);
+
+/**
+ * @brief Libera el segmento de estadisticas (master)
+ * @param stats Puntero al segmento (se pone en NULL)
+ * @param shared Si fue creado en memoria compartida
+ */
+void lock_stats_destroy(game_lock_stats_t **stats, bool shared);
+
+/**
+ * @brief Mapea el lugar de un jugador si el master publica las estadisticas
+ * @param player_id ID del jugador
+ * @return Lugar del jugador, o NULL si no hay segmento
+ */
+lock_slot_t *lock_stats_connect(int player_id);
+
+/**
+ * @brief Imprime los contadores de cada proceso y la espera del master como escritor
+ * @param stats Segmento de estadisticas
+ * @param player_count Cantidad de jugadores
+ */
+void lock_stats_print(const game_lock_stats_t *stats, int player_count);
+
+#endif // LOCK_STATS_H
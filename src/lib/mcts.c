@@ -0,0 +1,377 @@
+// This is a personal academic project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: https://pvs-studio.com
+#define _GNU_SOURCE
+#include "mcts.h"
+#include "common.h"
+#include "endgame.h"
+#include "engine.h"
+#include <math.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+// Nodo del arbol: estadisticas de una secuencia de movimientos propios
+typedef struct {
+	int children[ENGINE_DIRECTIONS]; // Indice del hijo por direccion (-1 si no existe)
+	unsigned int visits;			 // Cantidad de iteraciones que pasaron por el nodo
+	double value;					 // Suma de los resultados de esas iteraciones
+} mcts_node_t;
+
+// Busqueda de un thread
+typedef struct {
+	const engine_state_t *snapshot; // Snapshot compartido (solo lectura)
+	engine_state_t state;			// Copia privada sobre la que se simula
+	engine_undo_t *undo;			// Pila de movimientos para volver al snapshot
+	mcts_node_t *nodes;				// Arbol del thread
+	int node_count;					// Nodos usados
+	int player_id;					// Jugador que busca
+	unsigned long long rng;			// Estado del generador xorshift del thread
+	struct timespec deadline;		// Fin del presupuesto del turno
+	unsigned long iterations;		// Iteraciones del ultimo turno
+	pthread_t thread;				// Thread del worker
+} mcts_worker_t;
+
+typedef struct {
+	engine_state_t snapshot; // Copia privada del estado tomada en on_state
+	int player_id;			 // Jugador que usa la estrategia
+	long budget_ms;			 // Presupuesto por turno
+	int thread_count;		 // Cantidad de workers
+	mcts_worker_t *workers;	 // Workers (el primero corre en el thread que llama)
+	endgame_t endgame;		 // Solver exacto para regiones cerradas
+	bool endgame_ready;		 // Si el solver se pudo inicializar
+} mcts_t;
+
+/**
+ * @brief Generador xorshift64 (cada worker tiene el suyo, sin contencion)
+ */
+static unsigned int next_random(unsigned long long *rng) {
+	unsigned long long x = *rng;
+	x ^= x << 13;
+	x ^= x >> 7;
+	x ^= x << 17;
+	*rng = x;
+	return (unsigned int) (x >> 32);
+}
+
+static bool deadline_reached(const struct timespec *deadline) {
+	struct timespec now;
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return now.tv_sec > deadline->tv_sec || (now.tv_sec == deadline->tv_sec && now.tv_nsec >= deadline->tv_nsec);
+}
+
+/**
+ * @brief Lee un entero positivo de una variable de entorno
+ * @return El valor, o fallback si la variable no existe o no es valida
+ */
+static long env_long(const char *name, long fallback) {
+	const char *value = getenv(name);
+	if (value == NULL)
+		return fallback;
+	char *end;
+	long parsed = strtol(value, &end, 10);
+	return (*value != '\0' && *end == '\0' && parsed > 0) ? parsed : fallback;
+}
+
+/**
+ * @brief Elige un movimiento valido al azar para un jugador de la simulacion
+ * @return Direccion valida, o -1 si el jugador no puede moverse
+ */
+static int random_valid_move(mcts_worker_t *worker, int player_id) {
+	int start = (int) (next_random(&worker->rng) % ENGINE_DIRECTIONS);
+	for (int i = 0; i < ENGINE_DIRECTIONS; i++) {
+		int dir = (start + i) % ENGINE_DIRECTIONS;
+		if (engine_is_valid_move(&worker->state, player_id, (direction_t) dir)) {
+			return dir;
+		}
+	}
+	return -1;
+}
+
+static int new_node(mcts_worker_t *worker) {
+	if (worker->node_count >= MCTS_MAX_NODES)
+		return -1;
+	mcts_node_t *node = &worker->nodes[worker->node_count];
+	for (int dir = 0; dir < ENGINE_DIRECTIONS; dir++) {
+		node->children[dir] = -1;
+	}
+	node->visits = 0;
+	node->value = 0.0;
+	return worker->node_count++;
+}
+
+/**
+ * @brief Elige el movimiento propio dentro del arbol: expande un hijo nuevo o aplica UCB1
+ * @param worker Worker de la busqueda
+ * @param node_index Nodo actual
+ * @param child Indice del hijo elegido (-1 si no hay lugar para expandirlo)
+ * @param expanded true si el hijo se acaba de crear
+ * @return Direccion elegida, o -1 si no hay movimientos validos
+ */
+static int select_move(mcts_worker_t *worker, int node_index, int *child, bool *expanded) {
+	mcts_node_t *node = &worker->nodes[node_index];
+	int best_dir = -1;
+	double best_score = -1.0;
+	double log_visits = log((double) node->visits + 1.0);
+
+	int start = (int) (next_random(&worker->rng) % ENGINE_DIRECTIONS);
+	for (int i = 0; i < ENGINE_DIRECTIONS; i++) {
+		int dir = (start + i) % ENGINE_DIRECTIONS;
+		if (!engine_is_valid_move(&worker->state, worker->player_id, (direction_t) dir))
+			continue;
+
+		int index = node->children[dir];
+		if (index == -1) {
+			// Primero se prueba cada movimiento valido una vez
+			index = new_node(worker);
+			node = &worker->nodes[node_index];
+			node->children[dir] = index;
+			*child = index;
+			*expanded = true;
+			return dir;
+		}
+
+		const mcts_node_t *candidate = &worker->nodes[index];
+		double score = candidate->value / candidate->visits +
+					   MCTS_EXPLORATION * sqrt(log_visits / candidate->visits);
+		if (score > best_score) {
+			best_score = score;
+			best_dir = dir;
+		}
+	}
+
+	*child = (best_dir == -1) ? -1 : node->children[best_dir];
+	*expanded = false;
+	return best_dir;
+}
+
+/**
+ * @brief Una iteracion de MCTS: seleccion, expansion, simulacion y propagacion
+ */
+static void run_iteration(mcts_worker_t *worker) {
+	int path[MCTS_MAX_DEPTH + 1];
+	int path_length = 0;
+	int undo_count = 0;
+	int node = 0;
+	bool in_tree = true;
+	int me = worker->player_id;
+	int player_count = (int) worker->state.player_count;
+	unsigned int start_score = worker->state.players[me].score;
+
+	path[path_length++] = 0;
+
+	for (int depth = 0; depth < MCTS_MAX_DEPTH; depth++) {
+		int dir;
+		if (in_tree) {
+			int child;
+			bool expanded;
+			dir = select_move(worker, node, &child, &expanded);
+			if (child != -1) {
+				path[path_length++] = child;
+				node = child;
+			}
+			in_tree = (child != -1 && !expanded);
+		}
+		else {
+			dir = random_valid_move(worker, me);
+		}
+		if (dir == -1)
+			break;
+
+		engine_apply_move(&worker->state, me, (direction_t) dir, &worker->undo[undo_count++]);
+
+		// Turnos de los rivales, en el mismo orden de ronda que usa el master
+		for (int offset = 1; offset < player_count; offset++) {
+			int rival = (me + offset) % player_count;
+			int rival_dir = random_valid_move(worker, rival);
+			if (rival_dir != -1) {
+				engine_apply_move(&worker->state, rival, (direction_t) rival_dir, &worker->undo[undo_count++]);
+			}
+		}
+	}
+
+	double gain = worker->state.players[me].score - start_score;
+	double result = gain / (double) (ENGINE_MAX_REWARD * MCTS_MAX_DEPTH);
+
+	for (int i = 0; i < path_length; i++) {
+		worker->nodes[path[i]].visits++;
+		worker->nodes[path[i]].value += result;
+	}
+
+	while (undo_count > 0) {
+		engine_undo_move(&worker->state, &worker->undo[--undo_count]);
+	}
+}
+
+static void *worker_main(void *arg) {
+	mcts_worker_t *worker = arg;
+
+	engine_copy(&worker->state, worker->snapshot);
+	worker->node_count = 0;
+	new_node(worker);
+	worker->iterations = 0;
+
+	do {
+		// El reloj se consulta cada pocas iteraciones
+		for (int i = 0; i < 16; i++) {
+			run_iteration(worker);
+		}
+		worker->iterations += 16;
+	} while (!deadline_reached(&worker->deadline));
+
+	return NULL;
+}
+
+void *mcts_init(int player_id, const game_state_t *state) {
+	mcts_t *mcts = calloc(1, sizeof(mcts_t));
+	if (mcts == NULL) {
+		perror("Error allocating MCTS state");
+		return NULL;
+	}
+
+	mcts->player_id = player_id;
+
+	long timeout_sec = env_long(TIMEOUT_ENV, DEFAULT_TIMEOUT_SEC);
+	mcts->budget_ms = env_long(MCTS_BUDGET_ENV, timeout_sec * 1000 / MCTS_BUDGET_DIVISOR);
+	if (mcts->budget_ms < MCTS_MIN_BUDGET_MS) {
+		mcts->budget_ms = MCTS_MIN_BUDGET_MS;
+	}
+
+	long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+	mcts->thread_count = (int) env_long(MCTS_THREADS_ENV, cpus > 0 ? cpus : 1);
+	if (mcts->thread_count > MCTS_MAX_THREADS) {
+		mcts->thread_count = MCTS_MAX_THREADS;
+	}
+
+	size_t undo_size = (size_t) MCTS_MAX_DEPTH * MAX_PLAYERS;
+	bool ok = engine_create(&mcts->snapshot, state->width, state->height, state->player_count) == 0;
+	mcts->workers = ok ? calloc((size_t) mcts->thread_count, sizeof(mcts_worker_t)) : NULL;
+	ok = mcts->workers != NULL;
+
+	for (int i = 0; ok && i < mcts->thread_count; i++) {
+		mcts_worker_t *worker = &mcts->workers[i];
+		worker->snapshot = &mcts->snapshot;
+		worker->player_id = player_id;
+		worker->rng = ((unsigned long long) time(NULL) << 20) ^ ((unsigned long long) getpid() << 8) ^
+					  (unsigned long long) (i + 1) * 0x9E3779B97F4A7C15ULL;
+		worker->undo = malloc(undo_size * sizeof(engine_undo_t));
+		worker->nodes = malloc(MCTS_MAX_NODES * sizeof(mcts_node_t));
+		ok = worker->undo != NULL && worker->nodes != NULL &&
+			 engine_create(&worker->state, state->width, state->height, state->player_count) == 0;
+	}
+
+	// Sin solver se sigue jugando solo con MCTS
+	mcts->endgame_ready = ok && endgame_create(&mcts->endgame, state->width, state->height) == 0;
+
+	if (!ok) {
+		fprintf(stderr, "Error allocating MCTS workers\n");
+		mcts_destroy(mcts);
+		return NULL;
+	}
+
+	return mcts;
+}
+
+void mcts_on_state(void *data, int player_id, const game_state_t *state) {
+	(void) player_id;
+	mcts_t *mcts = data;
+	if (mcts != NULL) {
+		engine_load_game_state(&mcts->snapshot, state);
+	}
+}
+
+/**
+ * @brief Primer movimiento valido del snapshot (respaldo si no hubo tiempo para buscar)
+ */
+static direction_t first_valid_move(const mcts_t *mcts) {
+	for (int dir = 0; dir < ENGINE_DIRECTIONS; dir++) {
+		if (engine_is_valid_move(&mcts->snapshot, mcts->player_id, (direction_t) dir)) {
+			return (direction_t) dir;
+		}
+	}
+	return DIR_UP;
+}
+
+direction_t mcts_choose_move(void *data, int player_id, const game_state_t *state) {
+	(void) player_id;
+	(void) state;
+	mcts_t *mcts = data;
+	if (mcts == NULL)
+		return DIR_UP;
+
+	struct timespec deadline;
+	clock_gettime(CLOCK_MONOTONIC, &deadline);
+	deadline.tv_sec += mcts->budget_ms / 1000;
+	deadline.tv_nsec += (mcts->budget_ms % 1000) * 1000000L;
+	if (deadline.tv_nsec >= 1000000000L) {
+		deadline.tv_sec++;
+		deadline.tv_nsec -= 1000000000L;
+	}
+
+	// Si el final ya es chico y cerrado se juega la solucion exacta
+	direction_t exact_move;
+	if (mcts->endgame_ready &&
+		endgame_solve(&mcts->endgame, &mcts->snapshot, mcts->player_id, &deadline, &exact_move)) {
+		return exact_move;
+	}
+
+	// El worker 0 corre en el thread que llama; el resto en threads propios
+	int started = 1;
+	for (int i = 0; i < mcts->thread_count; i++) {
+		mcts->workers[i].deadline = deadline;
+	}
+	for (int i = 1; i < mcts->thread_count; i++) {
+		if (pthread_create(&mcts->workers[i].thread, NULL, worker_main, &mcts->workers[i]) != 0)
+			break;
+		started++;
+	}
+	worker_main(&mcts->workers[0]);
+	for (int i = 1; i < started; i++) {
+		pthread_join(mcts->workers[i].thread, NULL);
+	}
+
+	// Se suman las visitas de la raiz de todos los arboles
+	unsigned long visits[ENGINE_DIRECTIONS] = {0};
+	for (int i = 0; i < started; i++) {
+		const mcts_node_t *root = &mcts->workers[i].nodes[0];
+		for (int dir = 0; dir < ENGINE_DIRECTIONS; dir++) {
+			if (root->children[dir] != -1) {
+				visits[dir] += mcts->workers[i].nodes[root->children[dir]].visits;
+			}
+		}
+	}
+
+	int best_dir = -1;
+	for (int dir = 0; dir < ENGINE_DIRECTIONS; dir++) {
+		if (visits[dir] > 0 && (best_dir == -1 || visits[dir] > visits[best_dir])) {
+			best_dir = dir;
+		}
+	}
+
+	return (best_dir == -1) ? first_valid_move(mcts) : (direction_t) best_dir;
+}
+
+void mcts_destroy(void *data) {
+	mcts_t *mcts = data;
+	if (mcts == NULL)
+		return;
+
+	if (mcts->workers != NULL) {
+		for (int i = 0; i < mcts->thread_count; i++) {
+			engine_destroy(&mcts->workers[i].state);
+			free(mcts->workers[i].undo);
+			free(mcts->workers[i].nodes);
+		}
+		free(mcts->workers);
+	}
+	if (mcts->endgame_ready) {
+		endgame_destroy(&mcts->endgame);
+	}
+	engine_destroy(&mcts->snapshot);
+	free(mcts);
+}
+
+const strategy_t mcts_strategy = {STRATEGY_ABI_VERSION, MCTS_NAME, mcts_init, mcts_choose_move, mcts_on_state,
+								  mcts_destroy, 0, NULL};
@@ -0,0 +1,66 @@
+#ifndef MCTS_H
+#define MCTS_H
+
+#include "common.h"
+#include "strategy.h"
+
+/*
+ * Estrategia MCTS con presupuesto de tiempo por turno.
+ *
+ * En on_state se copia el estado compartido a un engine_state_t privado (con el lock de lectura tomado) y en
+ * choose_move se busca sin el lock: cada thread corre su propio arbol UCT sobre su copia del snapshot
+ * (paralelizacion de raiz) hasta agotar el presupuesto, y al final se suman las visitas de la raiz.
+ *
+ * Modelo de simulacion: los jugadores mueven en ronda empezando por el propio; el arbol solo contiene las
+ * decisiones propias y los rivales eligen un movimiento valido al azar (arbol de lazo abierto).
+ *
+ * Antes de buscar se prueba el solver exacto de finales (endgame.h): si la region del jugador es cerrada y chica se
+ * juega el movimiento optimo.
+ */
+
+#define MCTS_NAME "mcts"
+#define MCTS_BUDGET_ENV "CHOMP_MCTS_BUDGET_MS"
+#define MCTS_THREADS_ENV "CHOMP_MCTS_THREADS"
+#define MCTS_BUDGET_DIVISOR 100 // Fraccion del timeout del master usada por turno
+#define MCTS_MIN_BUDGET_MS 1
+#define MCTS_MAX_THREADS 8
+#define MCTS_MAX_DEPTH 48		   // Rondas simuladas por iteracion
+#define MCTS_MAX_NODES (1 << 16) // Nodos por thread
+#define MCTS_EXPLORATION 0.7	   // Constante de exploracion de UCB1
+
+/**
+ * @brief Crea el estado de la estrategia (copia privada del tablero y workers)
+ * @param player_id ID del jugador
+ * @param state Estado del juego (tomado como lector)
+ * @return Estado privado, o NULL en caso de error
+ * @details El presupuesto por turno es $CHOMP_MCTS_BUDGET_MS, o el timeout del master ($CHOMP_TIMEOUT_SEC)
+ * dividido MCTS_BUDGET_DIVISOR. La cantidad de threads es $CHOMP_MCTS_THREADS o la cantidad de CPUs.
+ */
+void *mcts_init(int player_id, const game_state_t *state);
+
+/**
+ * @brief Toma el snapshot del estado del juego (con el lock de lectura tomado)
+ * @param data Estado privado de la estrategia
+ * @param player_id ID del jugador
+ * @param state Estado del juego
+ */
+void mcts_on_state(void *data, int player_id, const game_state_t *state);
+
+/**
+ * @brief Busca sobre el ultimo snapshot hasta agotar el presupuesto y devuelve el movimiento mas visitado
+ * @param data Estado privado de la estrategia
+ * @param player_id ID del jugador
+ * @param state No se usa (la busqueda trabaja sobre el snapshot)
+ * @return Movimiento elegido
+ */
+direction_t mcts_choose_move(void *data, int player_id, const game_state_t *state);
+
+/**
+ * @brief Libera el estado de la estrategia
+ * @param data Estado privado de la estrategia
+ */
+void mcts_destroy(void *data);
+
+extern const strategy_t mcts_strategy;
+
+#endif // MCTS_H
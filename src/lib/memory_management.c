@@ -2,6 +2,7 @@
 // PVS-Studio Static Code Analyzer for C, C++, C#, and Java: https://pvs-studio.com
 #include "memory_management.h"
 #include "common.h"
+#include "engine.h"
 #include "library.h"
 #include <fcntl.h>
 #include <stdio.h>
@@ -15,7 +16,7 @@ int create_shared_memories(master_context_t *ctx) {
 	size_t sync_size = sizeof(game_sync_t);
 
 	// Crear memoria compartida para el estado del juego
-	ctx->state_fd = shm_open(GAME_STATE_SHM, O_CREAT | O_RDWR | O_EXCL, 0666);
+	ctx->state_fd = shm_open(shm_name(GAME_STATE_SHM), O_CREAT | O_RDWR | O_EXCL, 0666);
 	if (ctx->state_fd == -1) {
 		perror("Error creating game state shared memory");
 		return -1;
@@ -24,7 +25,7 @@ int create_shared_memories(master_context_t *ctx) {
 	if (ftruncate(ctx->state_fd, state_size) == -1) {
 		perror("Error setting game state size");
 		close(ctx->state_fd);
-		shm_unlink(GAME_STATE_SHM);
+		shm_unlink(shm_name(GAME_STATE_SHM));
 		return -1;
 	}
 
@@ -32,17 +33,17 @@ int create_shared_memories(master_context_t *ctx) {
 	if (ctx->game_state == MAP_FAILED) {
 		perror("Error mapping game state");
 		close(ctx->state_fd);
-		shm_unlink(GAME_STATE_SHM);
+		shm_unlink(shm_name(GAME_STATE_SHM));
 		return -1;
 	}
 
 	// Crear memoria compartida para sincronizacion
-	ctx->sync_fd = shm_open(GAME_SYNC_SHM, O_CREAT | O_RDWR | O_EXCL, 0666);
+	ctx->sync_fd = shm_open(shm_name(GAME_SYNC_SHM), O_CREAT | O_RDWR | O_EXCL, 0666);
 	if (ctx->sync_fd == -1) {
 		perror("Error creating game sync shared memory");
 		munmap(ctx->game_state, state_size);
 		close(ctx->state_fd);
-		shm_unlink(GAME_STATE_SHM);
+		shm_unlink(shm_name(GAME_STATE_SHM));
 		return -1;
 	}
 
@@ -50,9 +51,9 @@ int create_shared_memories(master_context_t *ctx) {
 		perror("Error setting game sync size");
 		munmap(ctx->game_state, state_size);
 		close(ctx->state_fd);
-		shm_unlink(GAME_STATE_SHM);
+		shm_unlink(shm_name(GAME_STATE_SHM));
 		close(ctx->sync_fd);
-		shm_unlink(GAME_SYNC_SHM);
+		shm_unlink(shm_name(GAME_SYNC_SHM));
 		return -1;
 	}
 
@@ -61,9 +62,30 @@ int create_shared_memories(master_context_t *ctx) {
 		perror("Error mapping game sync");
 		munmap(ctx->game_state, state_size);
 		close(ctx->state_fd);
-		shm_unlink(GAME_STATE_SHM);
+		shm_unlink(shm_name(GAME_STATE_SHM));
 		close(ctx->sync_fd);
-		shm_unlink(GAME_SYNC_SHM);
+		shm_unlink(shm_name(GAME_SYNC_SHM));
+		return -1;
+	}
+
+	return 0;
+}
+
+int create_private_memories(master_context_t *ctx) {
+	ctx->state_fd = -1;
+	ctx->sync_fd = -1;
+
+	ctx->game_state = malloc(calculate_game_state_size(ctx->config.width, ctx->config.height));
+	if (ctx->game_state == NULL) {
+		perror("Error allocating game state");
+		return -1;
+	}
+
+	ctx->game_sync = malloc(calculate_game_sync_size());
+	if (ctx->game_sync == NULL) {
+		perror("Error allocating game sync");
+		free(ctx->game_state);
+		ctx->game_state = NULL;
 		return -1;
 	}
 
@@ -83,12 +105,8 @@ void initialize_game_state(master_context_t *ctx) {
 		exit(EXIT_FAILURE);
 	}
 
-	srand(ctx->config.seed);
-
 	// Inicializar tablero con recompensas aleatorias (1-9)
-	for (int i = 0; i < ctx->config.width * ctx->config.height; i++) {
-		ctx->game_state->board[i] = (rand() % 9) + 1;
-	}
+	engine_fill_board(ctx->game_state->board, ctx->config.width * ctx->config.height, ctx->config.seed);
 
 	// Posicionar jugadores en el tablero
 	for (int i = 0; i < ctx->config.player_count; i++) {
@@ -116,83 +134,44 @@ void initialize_game_state(master_context_t *ctx) {
 }
 
 void initialize_synchronization(master_context_t *ctx) {
-	if (sem_init(&ctx->game_sync->view_ready, 1, 0) == -1) {
+	// En el modo con threads los semaforos solo se comparten entre threads del mismo proceso
+	int pshared = ctx->config.threads ? 0 : 1;
+
+	if (sem_init(&ctx->game_sync->view_ready, pshared, 0) == -1) {
 		perror("Error initializing view_ready semaphore");
 		exit(EXIT_FAILURE);
 	}
-	if (sem_init(&ctx->game_sync->view_done, 1, 0) == -1) {
+	if (sem_init(&ctx->game_sync->view_done, pshared, 0) == -1) {
 		perror("Error initializing view_done semaphore");
 		exit(EXIT_FAILURE);
 	}
-	if (sem_init(&ctx->game_sync->reader_writer_mutex, 1, 1) == -1) {
+	if (sem_init(&ctx->game_sync->reader_writer_mutex, pshared, 1) == -1) {
 		perror("Error initializing reader_writer_mutex semaphore");
 		exit(EXIT_FAILURE);
 	}
-	if (sem_init(&ctx->game_sync->state_mutex, 1, 1) == -1) {
+	if (sem_init(&ctx->game_sync->state_mutex, pshared, 1) == -1) {
 		perror("Error initializing state_mutex semaphore");
 		exit(EXIT_FAILURE);
 	}
-	if (sem_init(&ctx->game_sync->reader_count_mutex, 1, 1) == -1) {
+	if (sem_init(&ctx->game_sync->reader_count_mutex, pshared, 1) == -1) {
 		perror("Error initializing reader_count_mutex semaphore");
 		exit(EXIT_FAILURE);
 	}
 	ctx->game_sync->reader_count = 0;
 
 	for (int i = 0; i < MAX_PLAYERS; i++) {
-		if (sem_init(&ctx->game_sync->player_turn[i], 1, 0) == -1) {
+		if (sem_init(&ctx->game_sync->player_turn[i], pshared, 0) == -1) {
 			perror("Error initializing player_turn semaphore");
 			exit(EXIT_FAILURE);
 		}
 	}
+	if (sem_init(&ctx->game_sync->players_ready, pshared, 0) == -1) {
+		perror("Error initializing players_ready semaphore");
+		exit(EXIT_FAILURE);
+	}
 }
 
 void position_player_at_start(master_context_t *ctx, int player_id) {
-	// Distribucion simple: esquinas y bordes
-	if (player_id < 4) {
-		// Primeros 4 jugadores en las esquinas
-		switch (player_id) {
-			case 0:
-				ctx->game_state->players[player_id].x = 0;
-				ctx->game_state->players[player_id].y = 0;
-				break;
-			case 1:
-				ctx->game_state->players[player_id].x = ctx->config.width - 1;
-				ctx->game_state->players[player_id].y = 0;
-				break;
-			case 2:
-				ctx->game_state->players[player_id].x = 0;
-				ctx->game_state->players[player_id].y = ctx->config.height - 1;
-				break;
-			case 3:
-				ctx->game_state->players[player_id].x = ctx->config.width - 1;
-				ctx->game_state->players[player_id].y = ctx->config.height - 1;
-				break;
-		}
-	}
-	else {
-		// Jugadores adicionales en los bordes
-		int side = (player_id - 4) % 4;
-		int pos = (player_id - 4) / 4 + 1;
-
-		switch (side) {
-			case 0: // Borde superior
-				ctx->game_state->players[player_id].x = pos * ctx->config.width / (ctx->config.player_count - 3);
-				ctx->game_state->players[player_id].y = 0;
-				break;
-			case 1: // Borde derecho
-				ctx->game_state->players[player_id].x = ctx->config.width - 1;
-				ctx->game_state->players[player_id].y = pos * ctx->config.height / (ctx->config.player_count - 3);
-				break;
-			case 2: // Borde inferior
-				ctx->game_state->players[player_id].x =
-					ctx->config.width - 1 - pos * ctx->config.width / (ctx->config.player_count - 3);
-				ctx->game_state->players[player_id].y = ctx->config.height - 1;
-				break;
-			case 3: // Borde izquierdo
-				ctx->game_state->players[player_id].x = 0;
-				ctx->game_state->players[player_id].y =
-					ctx->config.height - 1 - pos * ctx->config.height / (ctx->config.player_count - 3);
-				break;
-		}
-	}
-}
+	engine_start_position(player_id, ctx->config.player_count, ctx->config.width, ctx->config.height,
+						  &ctx->game_state->players[player_id].x, &ctx->game_state->players[player_id].y);
+}
\ No newline at end of file
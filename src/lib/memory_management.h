@@ -10,6 +10,13 @@
  */
 int create_shared_memories(master_context_t *ctx);
 
+/**
+ * @brief Reserva el estado del juego y la sincronizacion en memoria privada (modo con threads)
+ * @param ctx Puntero al contexto del master
+ * @return 0 si la reserva fue exitosa, -1 en caso de error
+ */
+int create_private_memories(master_context_t *ctx);
+
 /**
  * @brief Inicializa el estado del juego
  * @param ctx Puntero al contexto del master
@@ -0,0 +1,395 @@
+// This is a personal academic project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: https://pvs-studio.com
+#define _GNU_SOURCE
+#include "placement.h"
+#include <errno.h>
+#include <sched.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#define SCHED_ROLES 3 // master, players, view
+
+// Clases de planificacion aceptadas por --sched
+static const struct {
+	const char *name;
+	int policy;
+} sched_classes[] = {
+	{"other", SCHED_OTHER}, {"batch", SCHED_BATCH}, {"idle", SCHED_IDLE}, {"fifo", SCHED_FIFO}, {"rr", SCHED_RR},
+};
+
+static const char *role_names[SCHED_ROLES] = {"master", "players", "view"};
+
+// Clase de planificacion de un rol
+typedef struct {
+	int policy;	  // Clase (-1: no se cambia)
+	int priority; // Prioridad estatica (0 salvo en fifo y rr)
+} sched_choice_t;
+
+static int policy_by_name(const char *name, size_t length) {
+	for (size_t i = 0; i < sizeof(sched_classes) / sizeof(sched_classes[0]); i++) {
+		if (strlen(sched_classes[i].name) == length && strncmp(sched_classes[i].name, name, length) == 0)
+			return sched_classes[i].policy;
+	}
+	return -1;
+}
+
+static const char *policy_name(int policy) {
+	for (size_t i = 0; i < sizeof(sched_classes) / sizeof(sched_classes[0]); i++) {
+		if (sched_classes[i].policy == policy)
+			return sched_classes[i].name;
+	}
+	return "?";
+}
+
+static int slot_role(const master_config_t *config, int slot) {
+	if (slot == PLACEMENT_MASTER)
+		return 0;
+	return (slot <= config->player_count) ? 1 : 2;
+}
+
+/**
+ * @brief Interpreta una clase de --sched; fifo y rr aceptan una prioridad con ":N"
+ * @return 0 si es valida, -1 si no (clase desconocida, prioridad en otra clase o fuera de rango)
+ */
+static int parse_class(const char *text, size_t length, sched_choice_t *choice) {
+	const char *colon = memchr(text, ':', length);
+	size_t name_length = (colon != NULL) ? (size_t) (colon - text) : length;
+	choice->policy = policy_by_name(text, name_length);
+	choice->priority = 0;
+	if (choice->policy == -1)
+		return -1;
+
+	// Las clases de tiempo real necesitan una prioridad; sin ":N" se usa la minima
+	bool realtime = choice->policy == SCHED_FIFO || choice->policy == SCHED_RR;
+	if (colon == NULL) {
+		choice->priority = realtime ? sched_get_priority_min(choice->policy) : 0;
+		return 0;
+	}
+	if (!realtime)
+		return -1;
+
+	char digits[16];
+	size_t digit_count = length - name_length - 1;
+	if (digit_count == 0 || digit_count >= sizeof(digits))
+		return -1;
+	memcpy(digits, colon + 1, digit_count);
+	digits[digit_count] = '\0';
+
+	char *end;
+	long priority = strtol(digits, &end, 10);
+	if (*end != '\0' || priority < sched_get_priority_min(choice->policy) ||
+		priority > sched_get_priority_max(choice->policy))
+		return -1;
+	choice->priority = (int) priority;
+	return 0;
+}
+
+/**
+ * @brief Clase de planificacion de cada rol segun --sched (policy -1: no se cambia)
+ * @return 0 si la opcion es valida, -1 si no
+ */
+static int parse_sched(const char *spec, sched_choice_t choices[SCHED_ROLES]) {
+	for (int i = 0; i < SCHED_ROLES; i++) {
+		choices[i].policy = -1;
+		choices[i].priority = 0;
+	}
+	if (spec == NULL)
+		return 0;
+
+	// Solo una clase: se aplica a los jugadores
+	if (strchr(spec, '=') == NULL)
+		return parse_class(spec, strlen(spec), &choices[1]);
+
+	const char *item = spec;
+	while (*item != '\0') {
+		const char *end = strchr(item, ',');
+		size_t length = (end != NULL) ? (size_t) (end - item) : strlen(item);
+		const char *equals = memchr(item, '=', length);
+		if (equals == NULL)
+			return -1;
+
+		int role = -1;
+		for (int i = 0; i < SCHED_ROLES; i++) {
+			if (strlen(role_names[i]) == (size_t) (equals - item) && strncmp(role_names[i], item, equals - item) == 0)
+				role = i;
+		}
+		if (role == -1 || parse_class(equals + 1, length - (size_t) (equals - item) - 1, &choices[role]) != 0)
+			return -1;
+
+		item += length;
+		if (*item == ',')
+			item++;
+	}
+	return 0;
+}
+
+/**
+ * @brief Devuelve la n-esima CPU (modulo la cantidad) entre las que el master tenia permitidas al arrancar
+ */
+static int allowed_cpu(int index) {
+	static cpu_set_t allowed;
+	static int count = -1;
+	if (count < 0) {
+		CPU_ZERO(&allowed);
+		if (sched_getaffinity(0, sizeof(allowed), &allowed) == -1)
+			return PLACEMENT_UNPINNED;
+		count = CPU_COUNT(&allowed);
+	}
+	if (count == 0)
+		return PLACEMENT_UNPINNED;
+
+	int target = index % count;
+	for (int cpu = 0; cpu < CPU_SETSIZE; cpu++) {
+		if (CPU_ISSET(cpu, &allowed) && target-- == 0)
+			return cpu;
+	}
+	return PLACEMENT_UNPINNED;
+}
+
+/**
+ * @brief Lee un numero de CPU y avanza el cursor
+ * @return 0 si habia un numero menor a CPU_SETSIZE, -1 si no
+ */
+static int parse_cpu(const char **cursor, const char *end, int *cpu) {
+	const char *c = *cursor;
+	if (c >= end || *c < '0' || *c > '9')
+		return -1;
+	int value = 0;
+	for (; c < end && *c >= '0' && *c <= '9'; c++) {
+		value = value * 10 + (*c - '0');
+		if (value >= CPU_SETSIZE)
+			return -1;
+	}
+	*cursor = c;
+	*cpu = value;
+	return 0;
+}
+
+/**
+ * @brief Lee un conjunto de CPUs: numeros o rangos a-b separados por separator (por ejemplo "0-3+6" o "0-1,4")
+ * @return 0 si todo el texto es un conjunto valido, -1 si no
+ */
+static int parse_cpu_set(const char *text, size_t length, char separator, cpu_set_t *set) {
+	CPU_ZERO(set);
+	const char *c = text, *end = text + length;
+	while (true) {
+		int first, last;
+		if (parse_cpu(&c, end, &first) != 0)
+			return -1;
+		last = first;
+		if (c < end && *c == '-') {
+			c++;
+			if (parse_cpu(&c, end, &last) != 0 || last < first)
+				return -1;
+		}
+		for (int cpu = first; cpu <= last; cpu++) {
+			CPU_SET(cpu, set);
+		}
+		if (c == end)
+			return 0;
+		if (*c++ != separator)
+			return -1;
+	}
+}
+
+/**
+ * @brief Elemento de la lista de --pin que corresponde a un lugar
+ * @param length Largo del elemento
+ * @return Inicio del elemento, o NULL si la lista es mas corta
+ */
+static const char *pin_item(const char *pin, int slot, size_t *length) {
+	const char *item = pin;
+	for (int i = 0; i < slot && item != NULL; i++) {
+		item = strchr(item, ',');
+		item = (item != NULL) ? item + 1 : NULL;
+	}
+	if (item != NULL) {
+		*length = strcspn(item, ",");
+	}
+	return item;
+}
+
+/**
+ * @brief CPUs hermanas (hilos SMT del mismo nucleo) de la CPU del master, leidas una vez de sysfs
+ * @return 0 si se pudieron leer, -1 si no
+ */
+static int master_siblings(cpu_set_t *siblings) {
+	static cpu_set_t cached;
+	static int status = 1;
+	if (status == 1 && allowed_cpu(0) == PLACEMENT_UNPINNED) {
+		status = -1;
+	}
+	else if (status == 1) {
+		char path[96], text[256] = "";
+		snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu%d/topology/thread_siblings_list", allowed_cpu(0));
+		FILE *file = fopen(path, "r");
+		bool read = file != NULL && fgets(text, sizeof(text), file) != NULL;
+		if (file != NULL) {
+			fclose(file);
+		}
+		status = (read && parse_cpu_set(text, strcspn(text, "\n"), ',', &cached) == 0) ? 0 : -1;
+	}
+	*siblings = cached;
+	return status;
+}
+
+bool placement_valid(const master_config_t *config) {
+	sched_choice_t choices[SCHED_ROLES];
+	if (parse_sched(config->sched, choices) != 0) {
+		fprintf(stderr,
+				"Error: Invalid --sched '%s' (other, batch, idle, fifo[:N], rr[:N] or role=class pairs, N in %d-%d)\n",
+				config->sched, sched_get_priority_min(SCHED_FIFO), sched_get_priority_max(SCHED_FIFO));
+		return false;
+	}
+
+	const char *pin = config->pin;
+	if (pin == NULL || strcmp(pin, "spread") == 0 || strcmp(pin, "same") == 0)
+		return true;
+
+	if (strcmp(pin, "sibling") == 0) {
+		cpu_set_t siblings;
+		if (master_siblings(&siblings) != 0) {
+			fprintf(stderr, "Error: Could not read the thread siblings of CPU %d for --pin sibling\n", allowed_cpu(0));
+			return false;
+		}
+		if (CPU_COUNT(&siblings) < 2) {
+			fprintf(stderr, "Warning: CPU %d has no SMT sibling, --pin sibling behaves like same\n", allowed_cpu(0));
+		}
+		return true;
+	}
+
+	// Cada elemento de la lista es "-" o un conjunto de CPUs
+	size_t length;
+	const char *item;
+	for (int slot = 0; (item = pin_item(pin, slot, &length)) != NULL; slot++) {
+		cpu_set_t set;
+		if (!(length == 1 && *item == '-') && parse_cpu_set(item, length, '+', &set) != 0) {
+			fprintf(stderr,
+					"Error: Invalid --pin '%s' (spread, same, sibling or a comma-separated list of CPU sets or -)\n",
+					pin);
+			return false;
+		}
+	}
+	return true;
+}
+
+/**
+ * @brief CPUs asignadas a un lugar segun --pin
+ * @param set Conjunto de CPUs del lugar
+ * @return true si el lugar queda fijado, false si no
+ */
+static bool placement_cpus(const master_config_t *config, int slot, cpu_set_t *set) {
+	const char *pin = config->pin;
+	CPU_ZERO(set);
+	if (pin == NULL)
+		return false;
+
+	int cpu = PLACEMENT_UNPINNED;
+	if (strcmp(pin, "spread") == 0) {
+		cpu = allowed_cpu(slot);
+	}
+	else if (strcmp(pin, "same") == 0) {
+		cpu = allowed_cpu(0);
+	}
+	else if (strcmp(pin, "sibling") == 0) {
+		// El master en su CPU y el resto en sus hermanas (o en la misma si no tiene)
+		cpu = allowed_cpu(0);
+		if (slot != PLACEMENT_MASTER && cpu != PLACEMENT_UNPINNED && master_siblings(set) == 0) {
+			CPU_CLR(cpu, set);
+			if (CPU_COUNT(set) > 0)
+				return true;
+		}
+	}
+	else {
+		// Lista explicita: el lugar n es el n-esimo elemento
+		size_t length;
+		const char *item = pin_item(pin, slot, &length);
+		return item != NULL && !(length == 1 && *item == '-') && parse_cpu_set(item, length, '+', set) == 0;
+	}
+
+	if (cpu == PLACEMENT_UNPINNED)
+		return false;
+	CPU_ZERO(set);
+	CPU_SET(cpu, set);
+	return true;
+}
+
+int placement_apply(master_context_t *ctx, pid_t pid, int slot) {
+	const master_config_t *config = &ctx->config;
+	int result = 0;
+
+	cpu_set_t set;
+	if (placement_cpus(config, slot, &set) && sched_setaffinity(pid, sizeof(set), &set) == -1) {
+		fprintf(stderr, "Warning: Could not pin %s to its CPUs: %s\n", role_names[slot_role(config, slot)],
+				strerror(errno));
+		result = -1;
+	}
+
+	sched_choice_t choices[SCHED_ROLES];
+	parse_sched(config->sched, choices);
+	const sched_choice_t *choice = &choices[slot_role(config, slot)];
+	if (choice->policy != -1) {
+		struct sched_param param = {.sched_priority = choice->priority};
+		if (sched_setscheduler(pid, choice->policy, &param) == -1) {
+			fprintf(stderr, "Warning: Could not set %s scheduling class to %s: %s\n",
+					role_names[slot_role(config, slot)], policy_name(choice->policy), strerror(errno));
+			result = -1;
+		}
+	}
+	ctx->placed++;
+	if (result != 0) {
+		ctx->placement_failures++;
+	}
+	return result;
+}
+
+/**
+ * @brief Imprime la afinidad y la clase de planificacion de un proceso
+ */
+static void report_process(const char *name, pid_t pid) {
+	cpu_set_t set;
+	CPU_ZERO(&set);
+	int policy = sched_getscheduler(pid);
+	if (sched_getaffinity(pid, sizeof(set), &set) == -1 || policy == -1) {
+		printf("   %-10s (PID: %d) exited\n", name, pid);
+		return;
+	}
+
+	char cpus[128] = "";
+	size_t used = 0;
+	for (int cpu = 0; cpu < CPU_SETSIZE && used < sizeof(cpus) - 8; cpu++) {
+		if (CPU_ISSET(cpu, &set)) {
+			used += (size_t) snprintf(cpus + used, sizeof(cpus) - used, "%s%d", used > 0 ? "," : "", cpu);
+		}
+	}
+	struct sched_param param = {.sched_priority = 0};
+	sched_getparam(pid, &param);
+	if (policy == SCHED_FIFO || policy == SCHED_RR) {
+		printf("   %-10s (PID: %d) CPUs %s, %s:%d\n", name, pid, cpus, policy_name(policy), param.sched_priority);
+	}
+	else {
+		printf("   %-10s (PID: %d) CPUs %s, %s\n", name, pid, cpus, policy_name(policy));
+	}
+}
+
+void placement_report(const master_context_t *ctx) {
+	printf("Placement:\n");
+	report_process("master", getpid());
+	for (int i = 0; ctx->player_pids != NULL && i < ctx->config.player_count; i++) {
+		char name[16];
+		snprintf(name, sizeof(name), "P%d", i + 1);
+		report_process(name, ctx->player_pids[i]);
+	}
+	if (ctx->view_active && ctx->view_pid > 0) {
+		report_process("view", ctx->view_pid);
+	}
+}
+
+void placement_summary(const master_context_t *ctx) {
+	const char *pin = (ctx->config.pin != NULL) ? ctx->config.pin : "-";
+	const char *sched = (ctx->config.sched != NULL) ? ctx->config.sched : "-";
+	printf("Placement: pin %s, sched %s, applied to %u of %u processes\n", pin, sched,
+		   ctx->placed - ctx->placement_failures, ctx->placed);
+}
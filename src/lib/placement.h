@@ -0,0 +1,53 @@
+#ifndef PLACEMENT_H
+#define PLACEMENT_H
+
+#include "common.h"
+
+/*
+ * Ubicacion de los procesos en las CPUs (--pin) y clase de planificacion (--sched).
+ *
+ * Cada proceso tiene un lugar: 0 es el master, 1..player_count los jugadores y player_count + 1 la vista.
+ * --pin acepta:
+ *   spread  cada proceso en una CPU distinta (en orden, dando la vuelta si hay menos CPUs que procesos)
+ *   same    todos en la misma CPU que el master (co-ubicados)
+ *   sibling el master en su CPU y el resto en los hilos SMT hermanos de esa CPU (thread_siblings_list de sysfs)
+ *   lista   un conjunto de CPUs por lugar, separados por coma y en el orden de los lugares, por ejemplo "0,1-3,2+5";
+ *           cada conjunto tiene numeros o rangos a-b unidos con "+", y "-" deja un lugar sin fijar
+ * --sched acepta una clase (other, batch, idle, fifo, rr) para los jugadores, o pares rol=clase separados por coma
+ * con los roles master, players y view, por ejemplo "master=fifo:50,players=batch". fifo y rr aceptan una prioridad
+ * con ":N" dentro del rango de sched_get_priority_min/max; sin ella usan la minima.
+ */
+
+#define PLACEMENT_MASTER 0 // Lugar del master
+#define PLACEMENT_UNPINNED -1
+
+/**
+ * @brief Valida las opciones --pin y --sched
+ * @param config Configuracion del master
+ * @return true si son validas (o no se usaron)
+ */
+bool placement_valid(const master_config_t *config);
+
+/**
+ * @brief Aplica la afinidad y la clase de planificacion de un lugar a un proceso
+ * @param ctx Puntero al contexto del master (cuenta los procesos ubicados y los fallos para placement_summary)
+ * @param pid Proceso (0: el propio)
+ * @param slot Lugar del proceso
+ * @return 0 si se aplico todo, -1 si algo fallo (se informa por stderr y el proceso sigue donde estaba)
+ */
+int placement_apply(master_context_t *ctx, pid_t pid, int slot);
+
+/**
+ * @brief Imprime la afinidad y la clase de planificacion efectivas de cada proceso
+ * @param ctx Puntero al contexto del master
+ */
+void placement_report(const master_context_t *ctx);
+
+/**
+ * @brief Imprime en una linea las opciones de ubicacion y a cuantos procesos se pudieron aplicar
+ * @param ctx Puntero al contexto del master
+ * @details Va con el reporte final: para entonces los hijos ya terminaron y placement_report no tiene que mostrar.
+ */
+void placement_summary(const master_context_t *ctx);
+
+#endif // PLACEMENT_H
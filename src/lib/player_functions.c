@@ -1,10 +1,18 @@
 // This is a personal academic project. Dear PVS-Studio, please check it.
 // PVS-Studio Static Code Analyzer for C, C++, C#, and Java: https://pvs-studio.com
 #include "player_functions.h"
+#include "analytics.h"
+#include "engine.h"
 #include "library.h"
+#include "lock_stats.h"
+#include "strategy.h"
+#include "syscall_stats.h"
+#include "trace.h"
 #include <signal.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
 #include <time.h>
 #include <unistd.h>
 
@@ -20,48 +28,51 @@ int find_my_player_id(player_context_t *ctx) {
 
 void enter_read_state(player_context_t *ctx) {
 	// lector-escritor para evitar inanicion
-	sem_wait(&ctx->game_sync->reader_writer_mutex); // Aseguro que no haya escritores esperando
-	sem_wait(&ctx->game_sync->reader_count_mutex);	// Aseguro exclusion mutua para reader_count
+	lock_slot_t *slot = ctx->lock_slot;
+	lock_enter(slot, LOCK_READER_WRITER, &ctx->game_sync->reader_writer_mutex); // Que no haya escritores esperando
+	lock_enter(slot, LOCK_READER_COUNT, &ctx->game_sync->reader_count_mutex);	// Exclusion mutua para reader_count
 
+	// Solo el primer lector espera state_mutex; el resto entra con el lock ya tomado
 	ctx->game_sync->reader_count++;
-	if (ctx->game_sync->reader_count == 1) {
-		sem_wait(&ctx->game_sync->state_mutex); // Espero mi turno y obtengo el estado del juego
-	}
+	bool first = (ctx->game_sync->reader_count == 1);
+	lock_enter(slot, LOCK_STATE, first ? &ctx->game_sync->state_mutex : NULL); // Obtengo el estado del juego
 
-	sem_post(&ctx->game_sync->reader_count_mutex);	// Libero exclusion mutua para reader_count
-	sem_post(&ctx->game_sync->reader_writer_mutex); // Libero para que otros lectores puedan entrar
+	lock_exit(slot, LOCK_READER_COUNT, &ctx->game_sync->reader_count_mutex);   // Libero reader_count
+	lock_exit(slot, LOCK_READER_WRITER, &ctx->game_sync->reader_writer_mutex); // Otros lectores pueden entrar
 }
 
 void exit_read_state(player_context_t *ctx) {
-	sem_wait(&ctx->game_sync->reader_count_mutex); // Aseguro exclusion mutua para reader_count
+	lock_slot_t *slot = ctx->lock_slot;
+	lock_enter(slot, LOCK_READER_COUNT, &ctx->game_sync->reader_count_mutex); // Exclusion mutua para reader_count
 
+	// El ultimo lector devuelve el estado del juego al resto
 	ctx->game_sync->reader_count--;
-	if (ctx->game_sync->reader_count == 0) {
-		sem_post(&ctx->game_sync->state_mutex); // Devuelvo el estado del juego al resto
-	}
+	bool last = (ctx->game_sync->reader_count == 0);
+	lock_exit(slot, LOCK_STATE, last ? &ctx->game_sync->state_mutex : NULL);
 
-	sem_post(&ctx->game_sync->reader_count_mutex); // Libero exclusion mutua para reader_count
+	lock_exit(slot, LOCK_READER_COUNT, &ctx->game_sync->reader_count_mutex); // Libero reader_count
 }
 
-direction_t choose_tornado_move(player_context_t *ctx, direction_t last_move, int cant_moves) {
-	if (!(is_valid_move(ctx->player_id, last_move, ctx->game_state) && cant_moves < 9)) {
+direction_t choose_tornado_move(int player_id, const game_state_t *game_state, direction_t last_move, int cant_moves) {
+	// Sin movimientos validos se corta la rotacion (el master marca al jugador como bloqueado)
+	if (cant_moves < 9 && !is_valid_move(player_id, last_move, game_state)) {
 		if (last_move == 0) {
 			last_move = 8;
 		}
-		last_move = choose_tornado_move(ctx, --last_move, ++cant_moves);
+		last_move = choose_tornado_move(player_id, game_state, --last_move, ++cant_moves);
 	}
 
 	return last_move;
 }
 
-direction_t choose_random_move() {
+direction_t choose_random_move(void) {
 	srand(time(NULL));
 
 	direction_t move = (rand() % 7);
 	return move;
 }
 
-direction_t select_first_move(int player_id, game_state_t *game_state) {
+direction_t select_first_move(int player_id, const game_state_t *game_state) {
 	int width = game_state->width;
 	int height = game_state->height;
 	int player_x = game_state->players[player_id].x;
@@ -88,8 +99,111 @@ direction_t select_first_move(int player_id, game_state_t *game_state) {
 	return direction;
 }
 
+// Estrategia tornado: el estado privado es la ultima direccion elegida
+static void *tornado_init(int player_id, const game_state_t *state) {
+	direction_t *last_move = malloc(sizeof(direction_t));
+	if (last_move != NULL) {
+		*last_move = select_first_move(player_id, state);
+	}
+	return last_move;
+}
+
+static direction_t tornado_choose_move(void *data, int player_id, const game_state_t *state) {
+	direction_t *last_move = data;
+	if (last_move == NULL) {
+		return choose_tornado_move(player_id, state, select_first_move(player_id, state), 0);
+	}
+
+	*last_move = choose_tornado_move(player_id, state, *last_move, 0);
+	return *last_move;
+}
+
+static void tornado_destroy(void *data) {
+	free(data);
+}
+
+// Estrategia random: no necesita estado privado
+static direction_t random_choose_move(void *data, int player_id, const game_state_t *state) {
+	(void) data;
+	(void) player_id;
+	(void) state;
+	return choose_random_move();
+}
+
+// Estrategia region: el estado privado es el segmento de analisis (NULL si el master no lo publica)
+typedef struct {
+	const game_analytics_t *analytics; // Segmento recibido en attach_analytics
+} region_data_t;
+
+static void *region_init(int player_id, const game_state_t *state) {
+	(void) player_id;
+	(void) state;
+	return calloc(1, sizeof(region_data_t));
+}
+
+static void region_attach(void *data, const struct game_analytics *analytics) {
+	region_data_t *region = data;
+	if (region != NULL) {
+		region->analytics = analytics;
+	}
+}
+
+static direction_t region_choose_move(void *data, int player_id, const game_state_t *state) {
+	const region_data_t *region = data;
+	const player_t *player = &state->players[player_id];
+	int cells[ENGINE_DIRECTIONS];
+	direction_t moves[ENGINE_DIRECTIONS];
+	int count = 0;
+
+	// Los movimientos se validan contra la copia del tablero; el analisis solo aporta el valor de cada destino
+	for (int dir = 0; dir < ENGINE_DIRECTIONS; dir++) {
+		int x, y;
+		if (engine_target(state->board, state->width, state->height, player->x, player->y, (direction_t) dir, &x, &y)) {
+			cells[count] = y * state->width + x;
+			moves[count++] = (direction_t) dir;
+		}
+	}
+	if (count == 0)
+		return DIR_UP;
+
+	analytics_region_t regions[ENGINE_DIRECTIONS];
+	memset(regions, 0, sizeof(regions));
+	if (region != NULL && region->analytics != NULL) {
+		analytics_read_regions(region->analytics, cells, count, regions);
+	}
+
+	// Recompensa de la region del destino repartida entre los jugadores que la rodean; despues la de la celda
+	int best = 0;
+	unsigned int best_value = 0;
+	for (int i = 0; i < count; i++) {
+		int sharing = __builtin_popcount(regions[i].player_mask);
+		unsigned int value = regions[i].reward / (unsigned int) (sharing > 0 ? sharing : 1);
+		bool richer = state->board[cells[i]] > state->board[cells[best]];
+		if (i == 0 || value > best_value || (value == best_value && richer)) {
+			best = i;
+			best_value = value;
+		}
+	}
+	return moves[best];
+}
+
+static void region_destroy(void *data) {
+	free(data);
+}
+
+const strategy_t tornado_strategy = {STRATEGY_ABI_VERSION, "tornado", tornado_init, tornado_choose_move, NULL,
+									 tornado_destroy, 0, NULL};
+
+// random no depende del tablero
+const strategy_t random_strategy = {STRATEGY_ABI_VERSION, "random", NULL, random_choose_move, NULL, NULL, 1, NULL};
+
+// region depende del analisis, que no es parte de la copia: no admite precalculo
+const strategy_t region_strategy = {STRATEGY_ABI_VERSION, "region", region_init, region_choose_move, NULL,
+									region_destroy, 0, region_attach};
+
 void send_move(direction_t move) {
 	unsigned char move_byte = (unsigned char) move;
+	syscall_count(SYSCALL_WRITE);
 	ssize_t bytes_written = write(STDOUT_FILENO, &move_byte, 1);
 	if (bytes_written != 1) {
 		perror("Error sending movement");
@@ -113,26 +227,136 @@ void initialize_player_context(player_context_t *ctx, int argc, char *argv[]) {
 		exit(EXIT_FAILURE);
 	}
 
-	// Encontrar ID de jugador
+	// Sin --lock-stats el segmento no existe y los locks quedan sin instrumentar
+	ctx->lock_slot = NULL;
+
+	// El master pasa el indice en PLAYER_ID_ENV; con otros masters se busca por PID
+	const char *id_env = getenv(PLAYER_ID_ENV);
+	int id = (id_env != NULL) ? atoi(id_env) : -1;
 	enter_read_state(ctx);
-	ctx->player_id = find_my_player_id(ctx);
+	ctx->player_id = (id >= 0 && (unsigned int) id < ctx->game_state->player_count) ? id : find_my_player_id(ctx);
 	exit_read_state(ctx);
 
 	if (ctx->player_id == -1) {
 		fprintf(stderr, "Error: Could not find player ID\n");
 		exit(EXIT_FAILURE);
 	}
+	ctx->lock_slot = lock_stats_connect(ctx->player_id);
+
+	char track[TRACE_NAME_LEN];
+	snprintf(track, sizeof(track), "P%d %s", ctx->player_id + 1, ctx->game_state->players[ctx->player_id].name);
+	ctx->trace_ring = trace_connect(ctx->player_id + 1, track);
+	syscall_stats_connect(ctx->player_id + 1);
+
+	// El analisis solo existe si el master corre con --analytics
+	ctx->analytics = analytics_connect(width, height, &ctx->analytics_fd);
+}
+
+/**
+ * @brief Aplica a la copia privada el movimiento enviado, como lo haria el master si sigue siendo valido
+ */
+static void predict_own_move(game_state_t *snapshot, int player_id, direction_t move) {
+	player_t *player = &snapshot->players[player_id];
+	int x, y;
+	if (!engine_target(snapshot->board, snapshot->width, snapshot->height, player->x, player->y, move, &x, &y))
+		return;
+
+	player->score += (unsigned int) snapshot->board[y * snapshot->width + x];
+	player->valid_moves++;
+	player->x = (unsigned short) x;
+	player->y = (unsigned short) y;
+	snapshot->board[y * snapshot->width + x] = -player_id;
+}
+
+/**
+ * @brief Verifica que el estado compartido coincida con la prediccion en todo lo que usa la estrategia
+ * @return true si la posicion es la prevista y ninguna celda dentro del radio cambio
+ */
+static bool speculation_holds(const game_state_t *state, const game_state_t *snapshot, int player_id,
+							  unsigned int radius) {
+	const player_t *player = &state->players[player_id];
+	const player_t *predicted = &snapshot->players[player_id];
+	if (player->x != predicted->x || player->y != predicted->y)
+		return false;
+
+	int x0 = (int) player->x - (int) radius, x1 = (int) player->x + (int) radius;
+	int y0 = (int) player->y - (int) radius, y1 = (int) player->y + (int) radius;
+	x0 = (x0 < 0) ? 0 : x0;
+	y0 = (y0 < 0) ? 0 : y0;
+	x1 = (x1 >= state->width) ? state->width - 1 : x1;
+	y1 = (y1 >= state->height) ? state->height - 1 : y1;
+
+	for (int y = y0; y <= y1; y++) {
+		const int *live = &state->board[y * state->width + x0];
+		const int *copy = &snapshot->board[y * state->width + x0];
+		if (memcmp(live, copy, (size_t) (x1 - x0 + 1) * sizeof(int)) != 0)
+			return false;
+	}
+	return true;
 }
 
-void player_main_loop(player_context_t *ctx, bool tornado_strategic) {
-	direction_t chosen_move = select_first_move(ctx->player_id, ctx->game_state);
+/**
+ * @brief Avisa players_ready al master
+ * @details Con un master que no tiene la barrera el segmento de sincronizacion es mas chico y no se avisa
+ */
+static void signal_ready(player_context_t *ctx) {
+	struct stat sync_stat;
+	if (ctx->sync_fd != -1 &&
+		(fstat(ctx->sync_fd, &sync_stat) == -1 || (size_t) sync_stat.st_size < sizeof(game_sync_t)))
+		return;
+	syscall_count(SYSCALL_SEM_POST);
+	sem_post(&ctx->game_sync->players_ready);
+}
+
+void player_main_loop(player_context_t *ctx, const char *strategy_name) {
+	strategy_instance_t strategy;
+	const char *speculation = getenv(SPECULATION_ENV);
+	unsigned long hits = 0, misses = 0;
+
+	// Copia privada del estado: el lock de lectura se mantiene solo mientras se copia
+	size_t state_size = calculate_game_state_size(ctx->game_state->width, ctx->game_state->height);
+	game_state_t *snapshot = malloc(state_size);
+	if (snapshot == NULL) {
+		perror("Error allocating game state snapshot");
+		return;
+	}
+
+	enter_read_state(ctx);
+	memcpy(snapshot, ctx->game_state, state_size);
+	int loaded = strategy_load(strategy_name, ctx->player_id, ctx->game_state, &strategy);
+	exit_read_state(ctx);
+	if (loaded == 0) {
+		strategy_attach_analytics(&strategy, ctx->analytics);
+	}
+
+	// Barrera de arranque: el master espera a que todos los jugadores esten listos (aunque la carga falle)
+	signal_ready(ctx);
+
+	if (loaded != 0) {
+		free(snapshot);
+		return;
+	}
+
+	unsigned int radius = strategy_dependency_radius(&strategy);
+	if (speculation != NULL && strcmp(speculation, "off") == 0) {
+		radius = 0;
+	}
+	bool speculated = false;
+	direction_t speculative_move = 0;
+
+	trace_ring_t *ring = ctx->trace_ring;
+	unsigned int track = (unsigned int) ctx->player_id;
 
 	while (true) {
-		if (sem_wait(&ctx->game_sync->player_turn[ctx->player_id]) != 0) {
+		unsigned long long span = trace_now(ring);
+		if (spin_wait(&ctx->game_sync->player_turn[ctx->player_id], 0, &ctx->turn_wait) != 0) {
 			perror("Error waiting for player turn");
 			break;
 		}
+		trace_span(ring, TRACE_TURN_WAIT, span, track);
 
+		// Fase de lectura: desde que se pide el lock hasta que se libera (incluye la copia del estado)
+		span = trace_now(ring);
 		enter_read_state(ctx); // Leer el estado del juego de forma sincronizada
 
 		if (ctx->game_state->game_finished || ctx->game_state->players[ctx->player_id].is_blocked) {
@@ -140,10 +364,57 @@ void player_main_loop(player_context_t *ctx, bool tornado_strategic) {
 			break;
 		}
 
-		chosen_move = (tornado_strategic ? choose_tornado_move(ctx, chosen_move, 0) : choose_random_move());
+		// Si la prediccion se cumplio, el movimiento precalculado es el que se hubiera elegido ahora
+		bool hit = speculated && speculation_holds(ctx->game_state, snapshot, ctx->player_id, radius);
+		if (hit) {
+			hits++;
+		}
+		else if (speculated) {
+			misses++;
+		}
+
+		// Las estrategias con on_state copian solo lo que necesitan; el resto recibe una copia completa
+		if (!hit && !strategy_observe(&strategy, ctx->game_state)) {
+			memcpy(snapshot, ctx->game_state, state_size);
+		}
 
 		exit_read_state(ctx);
+		trace_span(ring, TRACE_READ_LOCK, span, track);
+
+		// El calculo se hace sin el lock, asi el master no espera a la estrategia para escribir
+		span = trace_now(ring);
+		direction_t chosen_move = hit ? speculative_move : strategy_choose_move(&strategy, snapshot);
+		trace_span(ring, TRACE_STRATEGY, span, track);
 
-		send_move(chosen_move); // Enviar movimiento al master
+		// Enviar movimiento al master
+		span = trace_now(ring);
+		if (ctx->send_move_fn != NULL) {
+			ctx->send_move_fn(ctx->send_move_arg, chosen_move);
+		}
+		else {
+			send_move(chosen_move);
+		}
+		trace_span(ring, TRACE_SEND_MOVE, span, track);
+
+		// Mientras el master procesa el turno se calcula el siguiente sobre la copia
+		speculated = radius > 0;
+		if (speculated) {
+			span = trace_now(ring);
+			predict_own_move(snapshot, ctx->player_id, chosen_move);
+			speculative_move = strategy_choose_move(&strategy, snapshot);
+			trace_span(ring, TRACE_STRATEGY, span, track);
+		}
 	}
+
+	if (speculation != NULL && strcmp(speculation, "stats") == 0) {
+		fprintf(stderr, "Player %d speculation: %lu hits, %lu misses\n", ctx->player_id, hits, misses);
+	}
+	if (wait_stats_enabled()) {
+		char owner[32];
+		snprintf(owner, sizeof(owner), "Player %d", ctx->player_id);
+		print_wait_stats(stderr, owner, "player_turn", &ctx->turn_wait);
+	}
+
+	strategy_unload(&strategy);
+	free(snapshot);
 }
\ No newline at end of file
@@ -2,8 +2,16 @@
 #define PLAYER_FUNCTIONS_H
 
 #include "common.h"
+#include "strategy.h"
 #include <stdbool.h>
 
+#define SPECULATION_ENV "CHOMP_SPECULATION" // "off" desactiva el precalculo, "stats" informa aciertos al salir
+
+// Estrategias incluidas (ver strategy.h)
+extern const strategy_t tornado_strategy;
+extern const strategy_t random_strategy;
+extern const strategy_t region_strategy;
+
 /**
  * @brief Encuentra el ID del jugador actual basado en su PID
  * @param ctx Puntero al contexto del player
@@ -40,8 +48,11 @@ void initialize_player_context(player_context_t *ctx, int argc, char *argv[]);
 /**
  * @brief Bucle principal del player
  * @param ctx Puntero al contexto del player
- * @param tornado_strategic flag par estrategia
+ * @param strategy_name Nombre de la estrategia a cargar (ver strategy_load)
+ * @details Si la estrategia declara un dependency_radius, mientras espera el turno aplica su propio movimiento a la
+ * copia privada y calcula el siguiente. Al despertar lo envia sin recalcular si la posicion es la prevista y
+ * ninguna celda dentro del radio cambio; si no, copia el estado y calcula como siempre.
  */
-void player_main_loop(player_context_t *ctx, bool tornado_strategic);
+void player_main_loop(player_context_t *ctx, const char *strategy_name);
 
 #endif // PLAYER_FUNCTIONS_H
\ No newline at end of file
@@ -1,285 +1,428 @@
-// This is a personal academic project. Dear PVS-Studio, please check it.
-// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: https://pvs-studio.com
-#define _GNU_SOURCE
-#include "process_management.h"
-#include "common.h"
-#include "library.h"
-#include <signal.h>
-#include <stdio.h>
-#include <stdlib.h>
-#include <string.h>
-#include <sys/mman.h>
-#include <sys/wait.h>
-#include <unistd.h>
-
-bool is_process_alive(pid_t pid) {
-	if (pid <= 0)
-		return false;
-	return kill(pid, 0) == 0;
-}
-
-void cleanup_view_process(master_context_t *ctx) {
-	if (ctx->view_pid <= 0)
-		return;
-
-	int status;
-	pid_t result;
-
-	// 1. Verificar si ya termino
-	result = waitpid(ctx->view_pid, &status, WNOHANG);
-	if (result > 0) { // View termino
-		ctx->view_pid = -1;
-		ctx->view_active = false;
-		return;
-	}
-
-	// 2. Verificar si el proceso aun existe
-	if (!is_process_alive(ctx->view_pid)) {
-		ctx->view_pid = -1;
-		ctx->view_active = false;
-		return;
-	}
-
-	// 3. Terminacion con SIGTERM
-	if (kill(ctx->view_pid, SIGTERM) == -1) {
-		ctx->view_pid = -1;
-		ctx->view_active = false;
-		return;
-	}
-
-	// 4. Esperar terminacion con timeout
-	for (int i = 0; i < MAX_CLEANUP_ATTEMPTS; i++) {
-		usleep(CLEANUP_SLEEP_MS * 1000);
-
-		result = waitpid(ctx->view_pid, &status, WNOHANG);
-		if (result > 0) { // View termino
-			ctx->view_pid = -1;
-			ctx->view_active = false;
-			return;
-		}
-	}
-
-	// 5. Terminacion forzada con SIGKILL (solo si aun esta vivo)
-	if (is_process_alive(ctx->view_pid)) {
-		if (kill(ctx->view_pid, SIGKILL) == -1) {
-			perror("Error: sending SIGKILL to view");
-		}
-		else {
-			// Esperar terminacion forzada
-			waitpid(ctx->view_pid, &status, 0);
-		}
-	}
-
-	ctx->view_pid = -1;
-	ctx->view_active = false;
-}
-
-void master_cleanup(master_context_t *ctx) {
-	// 1. Limpiar view
-	cleanup_view_process(ctx);
-
-	// 2. Limpiar players
-	if (ctx->player_pids != NULL) {
-		for (int i = 0; i < ctx->config.player_count; i++) {
-			if (ctx->player_pids[i] > 0) {
-				// Verificar si el proceso aun esta vivo antes de enviar SIGTERM
-				if (is_process_alive(ctx->player_pids[i])) {
-					kill(ctx->player_pids[i], SIGTERM);
-					waitpid(ctx->player_pids[i], NULL, 0);
-				}
-				else {
-					// Proceso ya termino, recoger su estado
-					waitpid(ctx->player_pids[i], NULL, WNOHANG);
-				}
-			}
-		}
-		free(ctx->player_pids);
-		ctx->player_pids = NULL;
-	}
-
-	// 3. Limpiar pipes
-	if (ctx->player_pipes != NULL) {
-		for (int i = 0; i < ctx->config.player_count; i++) {
-			if (ctx->player_pipes[i] >= 0) {
-				close(ctx->player_pipes[i]);
-				ctx->player_pipes[i] = -1;
-			}
-		}
-		free(ctx->player_pipes);
-		ctx->player_pipes = NULL;
-	}
-
-	// 4. Limpiar file descriptors
-	if (ctx->sync_fd >= 0) {
-		close(ctx->sync_fd);
-		ctx->sync_fd = -1;
-	}
-
-	if (ctx->state_fd >= 0) {
-		close(ctx->state_fd);
-		ctx->state_fd = -1;
-	}
-
-	// 5. Limpiar memoria compartida
-	if (ctx->game_state != NULL) {
-		munmap(ctx->game_state, sizeof(game_state_t) + ctx->config.width * ctx->config.height * sizeof(int));
-		ctx->game_state = NULL;
-	}
-
-	if (ctx->game_sync != NULL) {
-		munmap(ctx->game_sync, sizeof(game_sync_t));
-		ctx->game_sync = NULL;
-	}
-
-	shm_unlink(GAME_STATE_SHM);
-	shm_unlink(GAME_SYNC_SHM);
-
-	// 6. Limpiar configuracion
-	if (ctx->config.player_paths != NULL) {
-		free(ctx->config.player_paths);
-		ctx->config.player_paths = NULL;
-	}
-}
-
-/**
- * @brief Funcion auxiliar para crear un proceso de jugador
- * @param ctx Puntero al contexto del master
- * @param player_id ID del jugador
- * @param width_str Ancho del tablero como cadena
- * @param height_str Alto del tablero como cadena
- * @return 0 si la creacion fue exitosa, -1 en caso de error
- */
-static int create_player_process(master_context_t *ctx, int player_id, const char *width_str, const char *height_str) {
-	int pipefd[2];
-	if (pipe(pipefd) == -1) {
-		perror("Error creating pipe for player");
-		return -1;
-	}
-
-	pid_t pid = fork();
-	if (pid == -1) {
-		perror("Error forking player process");
-		close(pipefd[0]);
-		close(pipefd[1]);
-		return -1;
-	}
-	else if (pid == 0) {
-		// Proceso hijo (player)
-
-		// Cierre de todos los pipes de otros jugadores que se heredaron del fork
-		for (int i = 0; i < ctx->config.player_count; i++) {
-			if (ctx->player_pipes[i] != -1) {
-				close(ctx->player_pipes[i]);
-			}
-		}
-
-		close(pipefd[0]);
-
-		if (dup2(pipefd[1], STDOUT_FILENO) == -1) {
-			perror("Error redirecting stdout in player");
-			close(pipefd[1]);
-			exit(EXIT_FAILURE);
-		}
-		close(pipefd[1]);
-
-		execl(ctx->config.player_paths[player_id], ctx->config.player_paths[player_id], width_str, height_str, NULL);
-		perror("Error executing player program");
-		exit(EXIT_FAILURE);
-	}
-	else {
-		// Proceso play creado
-		close(pipefd[1]);
-		ctx->player_pids[player_id] = pid;
-		ctx->player_pipes[player_id] = pipefd[0];
-		ctx->game_state->players[player_id].pid = pid;
-	}
-
-	return 0;
-}
-
-/**
- * @brief Funcion auxiliar para crear el proceso de vista
- * @param ctx Puntero al contexto del master
- * @param width_str Ancho del tablero como cadena
- * @param height_str Alto del tablero como cadena
- * @return 0 si la creacion fue exitosa, -1 en caso de error
- */
-static int create_view_process(master_context_t *ctx, const char *width_str, const char *height_str) {
-	ctx->view_pid = fork();
-	if (ctx->view_pid == -1) {
-		perror("Error forking view process");
-		ctx->config.view_path = NULL;
-		ctx->view_active = false;
-		return 0;
-	}
-	else if (ctx->view_pid == 0) {
-		execl(ctx->config.view_path, ctx->config.view_path, width_str, height_str, NULL);
-		perror("Error executing view program");
-		exit(EXIT_FAILURE);
-	}
-	else {
-		// proceso de la vista creada
-		ctx->view_active = true;
-	}
-
-	return 0;
-}
-
-/**
- * @brief Funcion auxiliar para limpiar procesos creados parcialmente
- * @param ctx Puntero al contexto del master
- * @param created_count Numero de procesos creados exitosamente
- */
-static void cleanup_partial_processes(master_context_t *ctx, int created_count) {
-	// Terminar procesos ya creados
-	for (int i = 0; i < created_count; i++) {
-		if (ctx->player_pids[i] > 0) {
-			kill(ctx->player_pids[i], SIGTERM);
-			waitpid(ctx->player_pids[i], NULL, 0);
-		}
-	}
-
-	// Liberar memoria
-	free(ctx->player_pids);
-	free(ctx->player_pipes);
-	ctx->player_pids = NULL;
-	ctx->player_pipes = NULL;
-}
-
-int create_processes(master_context_t *ctx) {
-	ctx->player_pids = calloc(ctx->config.player_count, sizeof(pid_t));
-	if (ctx->player_pids == NULL) {
-		perror("Error allocating memory for player PIDs");
-		return -1;
-	}
-
-	ctx->player_pipes = malloc(ctx->config.player_count * sizeof(int));
-	if (ctx->player_pipes == NULL) {
-		perror("Error allocating memory for player pipes");
-		free(ctx->player_pids);
-		ctx->player_pids = NULL;
-		return -1;
-	}
-
-	char width_str[16], height_str[16];
-	snprintf(width_str, sizeof(width_str), "%d", ctx->config.width);
-	snprintf(height_str, sizeof(height_str), "%d", ctx->config.height);
-
-	for (int i = 0; i < ctx->config.player_count; i++) {
-		if (create_player_process(ctx, i, width_str, height_str) != 0) {
-			// Cleanup: terminar procesos ya creados
-			cleanup_partial_processes(ctx, i);
-			return -1;
-		}
-	}
-
-	if (ctx->config.view_path != NULL) {
-		if (create_view_process(ctx, width_str, height_str) != 0) {
-			// Cleanup: terminar todos los procesos creados
-			cleanup_partial_processes(ctx, ctx->config.player_count);
-			return -1;
-		}
-	}
-
-	return 0;
-}
+// This is a personal academic project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: https://pvs-studio.com
+#define _GNU_SOURCE
+#include "process_management.h"
+#include "analytics.h"
+#include "common.h"
+#include "game_record.h"
+#include "library.h"
+#include "live_stats.h"
+#include "lock_stats.h"
+#include "placement.h"
+#include "syscall_stats.h"
+#include "trace.h"
+#include <errno.h>
+#include <limits.h>
+#include <poll.h>
+#include <signal.h>
+#include <spawn.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/signalfd.h>
+#include <sys/syscall.h>
+#include <sys/wait.h>
+#include <time.h>
+#include <unistd.h>
+
+bool is_process_alive(pid_t pid) {
+	if (pid <= 0)
+		return false;
+
+	// Un hijo que termino sigue respondiendo a kill hasta que se lo recoge: se consulta sin recogerlo
+	siginfo_t info;
+	memset(&info, 0, sizeof(info));
+	syscall_count(SYSCALL_WAITID);
+	if (waitid(P_PID, (id_t) pid, &info, WEXITED | WNOHANG | WNOWAIT) == 0 && info.si_pid == pid)
+		return false;
+	syscall_count(SYSCALL_KILL);
+	return kill(pid, 0) == 0;
+}
+
+int child_exit_code(int status) {
+	if (WIFEXITED(status))
+		return WEXITSTATUS(status);
+	if (WIFSIGNALED(status))
+		return WTERMSIG(status);
+	return 0;
+}
+
+// Hijo pendiente de recoger
+typedef struct {
+	pid_t pid;			  // PID del hijo
+	int *status;		  // Donde guardar el estado de salida
+	bool *reaped;		  // Marca de recogido en el contexto
+	struct rusage *usage; // Donde guardar los recursos que consumio
+	int fd;				  // pidfd del hijo (-1 si no hay)
+} pending_child_t;
+
+static long elapsed_ms(const struct timespec *since) {
+	struct timespec now;
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return (now.tv_sec - since->tv_sec) * 1000L + (now.tv_nsec - since->tv_nsec) / 1000000L;
+}
+
+/**
+ * @brief Recoge sin bloquear a los hijos pendientes que ya terminaron
+ * @return Cantidad de hijos que siguen pendientes
+ */
+static int collect_exited(pending_child_t *children, int count) {
+	int pending = 0;
+	for (int i = 0; i < count; i++) {
+		if (*children[i].reaped)
+			continue;
+
+		// wait4 devuelve ademas los recursos consumidos por el hijo
+		int status = 0;
+		pid_t result = wait4(children[i].pid, &status, WNOHANG, children[i].usage);
+		if (result == children[i].pid || (result == -1 && errno == ECHILD)) {
+			*children[i].status = (result == -1) ? 0 : status;
+			*children[i].reaped = true;
+			if (children[i].fd != -1) {
+				close(children[i].fd);
+				children[i].fd = -1;
+			}
+			continue;
+		}
+		pending++;
+	}
+	return pending;
+}
+
+/**
+ * @brief Espera hasta que terminen todos los pendientes o venza el plazo
+ * @param signal_fd signalfd de SIGCHLD, o -1 si todos los hijos tienen pidfd
+ * @return Cantidad de hijos que siguen pendientes
+ */
+static int wait_exited(pending_child_t *children, int count, int signal_fd, int timeout_ms) {
+	struct timespec start;
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	int pending = collect_exited(children, count);
+
+	while (pending > 0) {
+		long remaining = timeout_ms - elapsed_ms(&start);
+		if (remaining <= 0)
+			break;
+
+		struct pollfd fds[MAX_PLAYERS + 1];
+		int nfds = 0;
+		if (signal_fd != -1) {
+			fds[nfds++] = (struct pollfd){.fd = signal_fd, .events = POLLIN};
+		}
+		else {
+			for (int i = 0; i < count; i++) {
+				if (children[i].fd != -1) {
+					fds[nfds++] = (struct pollfd){.fd = children[i].fd, .events = POLLIN};
+				}
+			}
+		}
+
+		if (poll(fds, (nfds_t) nfds, (int) remaining) == -1 && errno != EINTR) {
+			perror("Error waiting for child processes");
+			break;
+		}
+		if (signal_fd != -1) {
+			struct signalfd_siginfo info;
+			while (read(signal_fd, &info, sizeof(info)) == (ssize_t) sizeof(info)) {
+			}
+		}
+		pending = collect_exited(children, count);
+	}
+	return pending;
+}
+
+static void signal_pending(pending_child_t *children, int count, int sig) {
+	for (int i = 0; i < count; i++) {
+		if (!*children[i].reaped) {
+			kill(children[i].pid, sig);
+		}
+	}
+}
+
+void reap_children(master_context_t *ctx, int grace_ms, int term_ms) {
+	pending_child_t children[MAX_PLAYERS + 1];
+	int count = 0;
+
+	for (int i = 0; ctx->player_pids != NULL && i < ctx->config.player_count; i++) {
+		if (ctx->player_pids[i] > 0 && !ctx->player_reaped[i]) {
+			children[count++] = (pending_child_t){ctx->player_pids[i], &ctx->player_status[i], &ctx->player_reaped[i],
+												  &ctx->player_usage[i], -1};
+		}
+	}
+	if (ctx->view_pid > 0 && !ctx->view_reaped) {
+		children[count++] =
+			(pending_child_t){ctx->view_pid, &ctx->view_status, &ctx->view_reaped, &ctx->view_usage, -1};
+	}
+	if (count == 0)
+		return;
+
+	// Un pidfd por hijo se vuelve legible cuando el hijo termina; sin pidfd_open se espera SIGCHLD por signalfd
+	bool use_pidfd = false;
+#ifdef SYS_pidfd_open
+	use_pidfd = true;
+	for (int i = 0; i < count && use_pidfd; i++) {
+		children[i].fd = (int) syscall(SYS_pidfd_open, children[i].pid, 0);
+		use_pidfd = children[i].fd != -1 || errno == ESRCH; // ESRCH: ya fue recogido
+	}
+#endif
+
+	int signal_fd = -1;
+	sigset_t sigchld, previous;
+	if (!use_pidfd) {
+		sigemptyset(&sigchld);
+		sigaddset(&sigchld, SIGCHLD);
+		sigprocmask(SIG_BLOCK, &sigchld, &previous);
+		signal_fd = signalfd(-1, &sigchld, SFD_NONBLOCK | SFD_CLOEXEC);
+	}
+
+	int pending = wait_exited(children, count, signal_fd, grace_ms);
+	if (pending > 0) {
+		// SIGTERM a todos juntos: los plazos de terminacion corren en paralelo
+		signal_pending(children, count, SIGTERM);
+		pending = wait_exited(children, count, signal_fd, term_ms);
+	}
+	if (pending > 0) {
+		signal_pending(children, count, SIGKILL);
+		for (int i = 0; i < count; i++) {
+			if (!*children[i].reaped && wait4(children[i].pid, children[i].status, 0, children[i].usage) != -1) {
+				*children[i].reaped = true;
+			}
+		}
+	}
+
+	for (int i = 0; i < count; i++) {
+		if (children[i].fd != -1) {
+			close(children[i].fd);
+		}
+	}
+	if (!use_pidfd) {
+		if (signal_fd != -1) {
+			close(signal_fd);
+		}
+		sigprocmask(SIG_SETMASK, &previous, NULL);
+	}
+}
+
+void master_cleanup(master_context_t *ctx) {
+	// 1 y 2. Recoger view y players (SIGTERM inmediato a los que sigan vivos)
+	reap_children(ctx, 0, REAP_TERM_MS);
+	ctx->view_pid = -1;
+	ctx->view_active = false;
+	if (ctx->player_pids != NULL) {
+		free(ctx->player_pids);
+		ctx->player_pids = NULL;
+	}
+
+	// 3. Limpiar pipes
+	if (ctx->player_pipes != NULL) {
+		for (int i = 0; i < ctx->config.player_count; i++) {
+			if (ctx->player_pipes[i] >= 0) {
+				close(ctx->player_pipes[i]);
+				ctx->player_pipes[i] = -1;
+			}
+		}
+		free(ctx->player_pipes);
+		ctx->player_pipes = NULL;
+	}
+
+	// 4. Limpiar file descriptors
+	if (ctx->sync_fd >= 0) {
+		close(ctx->sync_fd);
+		ctx->sync_fd = -1;
+	}
+
+	if (ctx->state_fd >= 0) {
+		close(ctx->state_fd);
+		ctx->state_fd = -1;
+	}
+
+	// 5. Cerrar la grabacion (si quedo abierta por una terminacion anticipada) y limpiar memoria compartida
+	//    (incluidos los segmentos de analisis y de estadisticas)
+	if (ctx->game_state != NULL) {
+		record_close(ctx);
+	}
+	analytics_destroy(ctx);
+	live_stats_destroy(ctx);
+	trace_destroy(ctx); // Los hijos ya fueron recogidos: sus anillos estan completos
+	if (!ctx->config.threads || ctx->threads == NULL) {
+		syscall_stats_destroy(&ctx->syscalls, !ctx->config.threads);
+	}
+	if (!ctx->config.threads || ctx->threads == NULL) {
+		lock_stats_destroy(&ctx->lock_stats, !ctx->config.threads);
+	}
+
+	if (ctx->config.threads) {
+		// Modo con threads: la memoria es privada y no hay segmentos que desvincular. Si los threads siguen vivos
+		// (terminacion por señal) la memoria se libera al salir del proceso.
+		if (ctx->threads == NULL) {
+			free(ctx->game_state);
+			free(ctx->game_sync);
+			ctx->game_state = NULL;
+			ctx->game_sync = NULL;
+		}
+	}
+	else {
+		if (ctx->game_state != NULL) {
+			munmap(ctx->game_state, sizeof(game_state_t) + ctx->config.width * ctx->config.height * sizeof(int));
+			ctx->game_state = NULL;
+		}
+
+		if (ctx->game_sync != NULL) {
+			munmap(ctx->game_sync, sizeof(game_sync_t));
+			ctx->game_sync = NULL;
+		}
+
+		shm_unlink(shm_name(GAME_STATE_SHM));
+		shm_unlink(shm_name(GAME_SYNC_SHM));
+	}
+
+	// 6. Limpiar configuracion
+	if (ctx->config.player_paths != NULL) {
+		free(ctx->config.player_paths);
+		ctx->config.player_paths = NULL;
+	}
+}
+
+/**
+ * @brief Funcion auxiliar para crear un proceso de jugador
+ * @param ctx Puntero al contexto del master
+ * @param player_id ID del jugador
+ * @param width_str Ancho del tablero como cadena
+ * @param height_str Alto del tablero como cadena
+ * @return 0 si la creacion fue exitosa, -1 en caso de error
+ * @details Usa posix_spawn (vfork + exec en glibc): no se copian las tablas de paginas del master. El indice del
+ * jugador se pasa en PLAYER_ID_ENV, asi el jugador no depende de que el master ya haya escrito su PID.
+ */
+static int create_player_process(master_context_t *ctx, int player_id, const char *width_str, const char *height_str) {
+	int pipefd[2];
+	if (pipe(pipefd) == -1) {
+		perror("Error creating pipe for player");
+		return -1;
+	}
+
+	// Cierre de todos los pipes de otros jugadores y redireccion de stdout al pipe propio
+	posix_spawn_file_actions_t actions;
+	posix_spawn_file_actions_init(&actions);
+	for (int i = 0; i < player_id; i++) {
+		if (ctx->player_pipes[i] != -1) {
+			posix_spawn_file_actions_addclose(&actions, ctx->player_pipes[i]);
+		}
+	}
+	posix_spawn_file_actions_addclose(&actions, pipefd[0]);
+	posix_spawn_file_actions_adddup2(&actions, pipefd[1], STDOUT_FILENO);
+	posix_spawn_file_actions_addclose(&actions, pipefd[1]);
+
+	// "binario:estrategia" se pasa como tercer parametro al jugador
+	char binary[PATH_MAX];
+	const char *strategy = split_player_spec(ctx->config.player_paths[player_id], binary, sizeof(binary));
+	char *argv[] = {binary, (char *) width_str, (char *) height_str, (char *) strategy, NULL};
+
+	char id_str[16];
+	snprintf(id_str, sizeof(id_str), "%d", player_id);
+	setenv(PLAYER_ID_ENV, id_str, 1);
+
+	pid_t pid;
+	int error = posix_spawn(&pid, binary, &actions, NULL, argv, environ);
+	posix_spawn_file_actions_destroy(&actions);
+	close(pipefd[1]);
+	if (error != 0) {
+		fprintf(stderr, "Error executing player program %s: %s\n", binary, strerror(error));
+		close(pipefd[0]);
+		return -1;
+	}
+
+	ctx->player_pids[player_id] = pid;
+	ctx->player_pipes[player_id] = pipefd[0];
+	ctx->game_state->players[player_id].pid = pid;
+	placement_apply(ctx, pid, player_id + 1);
+	return 0;
+}
+
+/**
+ * @brief Funcion auxiliar para crear el proceso de vista
+ * @param ctx Puntero al contexto del master
+ * @param width_str Ancho del tablero como cadena
+ * @param height_str Alto del tablero como cadena
+ * @return 0 (si la vista no se puede ejecutar la partida sigue sin vista)
+ */
+static int create_view_process(master_context_t *ctx, const char *width_str, const char *height_str) {
+	char *argv[] = {ctx->config.view_path, (char *) width_str, (char *) height_str, NULL};
+
+	// La vista no hereda los pipes de los jugadores
+	posix_spawn_file_actions_t actions;
+	posix_spawn_file_actions_init(&actions);
+	for (int i = 0; i < ctx->config.player_count; i++) {
+		posix_spawn_file_actions_addclose(&actions, ctx->player_pipes[i]);
+	}
+
+	int error = posix_spawn(&ctx->view_pid, ctx->config.view_path, &actions, NULL, argv, environ);
+	posix_spawn_file_actions_destroy(&actions);
+	if (error != 0) {
+		fprintf(stderr, "Error executing view program %s: %s\n", ctx->config.view_path, strerror(error));
+		ctx->view_pid = -1;
+		ctx->config.view_path = NULL;
+		ctx->view_active = false;
+		return 0;
+	}
+
+	// proceso de la vista creada
+	ctx->view_active = true;
+	placement_apply(ctx, ctx->view_pid, ctx->config.player_count + 1);
+	return 0;
+}
+
+/**
+ * @brief Funcion auxiliar para limpiar procesos creados parcialmente
+ * @param ctx Puntero al contexto del master
+ */
+static void cleanup_partial_processes(master_context_t *ctx) {
+	// Terminar procesos ya creados (los que no se crearon tienen PID 0)
+	reap_children(ctx, 0, REAP_TERM_MS);
+
+	// Liberar memoria
+	free(ctx->player_pids);
+	free(ctx->player_pipes);
+	ctx->player_pids = NULL;
+	ctx->player_pipes = NULL;
+}
+
+int create_processes(master_context_t *ctx) {
+	ctx->player_pids = calloc(ctx->config.player_count, sizeof(pid_t));
+	if (ctx->player_pids == NULL) {
+		perror("Error allocating memory for player PIDs");
+		return -1;
+	}
+
+	ctx->player_pipes = malloc(ctx->config.player_count * sizeof(int));
+	if (ctx->player_pipes == NULL) {
+		perror("Error allocating memory for player pipes");
+		free(ctx->player_pids);
+		ctx->player_pids = NULL;
+		return -1;
+	}
+
+	char width_str[16], height_str[16];
+	snprintf(width_str, sizeof(width_str), "%d", ctx->config.width);
+	snprintf(height_str, sizeof(height_str), "%d", ctx->config.height);
+
+	clock_gettime(CLOCK_MONOTONIC, &ctx->start_time);
+	for (int i = 0; i < ctx->config.player_count; i++) {
+		if (create_player_process(ctx, i, width_str, height_str) != 0) {
+			// Cleanup: terminar procesos ya creados
+			cleanup_partial_processes(ctx);
+			return -1;
+		}
+	}
+	unsetenv(PLAYER_ID_ENV);
+
+	if (ctx->config.view_path != NULL) {
+		if (create_view_process(ctx, width_str, height_str) != 0) {
+			// Cleanup: terminar todos los procesos creados
+			cleanup_partial_processes(ctx);
+			return -1;
+		}
+	}
+
+	return 0;
+}
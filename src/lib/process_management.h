@@ -11,11 +11,22 @@
 bool is_process_alive(pid_t pid);
 
 /**
- * @brief Limpia el proceso de view de forma segura
+ * @brief Recoge a los jugadores y la vista con plazos acotados, sin sondear
  * @param ctx Puntero al contexto del master
- * @details Verifica si ya termino, envia SIGTERM y finalmente SIGKILL si es necesario. Previene procesos zombie.
+ * @param grace_ms Plazo para que terminen solos antes de enviar SIGTERM (0: SIGTERM inmediato)
+ * @param term_ms Plazo despues de SIGTERM antes de enviar SIGKILL a los que sigan vivos
+ * @details Espera a todos los hijos a la vez sobre un pidfd por hijo (o un signalfd de SIGCHLD si pidfd_open no
+ * esta disponible), envia SIGTERM a todos juntos y SIGKILL solo a los rezagados. El estado de salida de cada uno
+ * queda en player_status/view_status. Se puede llamar mas de una vez: solo espera a los que no se recogieron.
  */
-void cleanup_view_process(master_context_t *ctx);
+void reap_children(master_context_t *ctx, int grace_ms, int term_ms);
+
+/**
+ * @brief Convierte un estado de waitpid en el codigo que se informa (codigo de salida o numero de señal)
+ * @param status Estado devuelto por waitpid
+ * @return Codigo de salida, o numero de señal si el proceso termino por una señal
+ */
+int child_exit_code(int status);
 
 /**
  * @brief Limpia todos los recursos del master
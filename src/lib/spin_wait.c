@@ -0,0 +1,118 @@
+// This is a personal academic project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: https://pvs-studio.com
+#define _GNU_SOURCE
+#include "spin_wait.h"
+#include "syscall_stats.h"
+#include <errno.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
+
+static int budget_us = -1; // Se calcula en el primer uso
+
+/**
+ * @brief Le indica a la CPU que esta en un spin (libera recursos para el otro hilo del core)
+ */
+static inline void cpu_relax(void) {
+#if defined(__x86_64__) || defined(__i386__)
+	__builtin_ia32_pause();
+#elif defined(__aarch64__)
+	__asm__ __volatile__("yield");
+#endif
+}
+
+static unsigned long long now_ns(void) {
+	struct timespec now;
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return (unsigned long long) now.tv_sec * 1000000000ULL + (unsigned long long) now.tv_nsec;
+}
+
+unsigned int spin_wait_budget_us(void) {
+	if (budget_us < 0) {
+		const char *env = getenv(SPIN_ENV);
+		if (env != NULL && *env != '\0') {
+			long value = strtol(env, NULL, 10);
+			budget_us = (int) (value < 0 ? 0 : (value > SPIN_MAX_US ? SPIN_MAX_US : value));
+		}
+		else {
+			budget_us = (sysconf(_SC_NPROCESSORS_ONLN) > 1) ? SPIN_DEFAULT_US : 0;
+		}
+	}
+	return (unsigned int) budget_us;
+}
+
+/**
+ * @brief Intenta tomar el semaforo sin bloquear hasta que se agote el tiempo de spin
+ * @return 0 si se obtuvo el semaforo, -1 si no
+ */
+static int spin(sem_t *sem, unsigned long long start, unsigned int spin_us) {
+	unsigned long long spin_end = start + (unsigned long long) spin_us * 1000ULL;
+	unsigned int attempts = 0;
+
+	// Se cuenta una vez por espera: los reintentos del spin no entran al kernel
+	syscall_count(SYSCALL_SEM_TRYWAIT);
+	while (true) {
+		if (sem_trywait(sem) == 0)
+			return 0;
+		if (errno != EAGAIN && errno != EINTR)
+			return -1;
+		cpu_relax();
+		if (++attempts % SPIN_CHECK_INTERVAL == 0 && now_ns() >= spin_end)
+			return -1;
+	}
+}
+
+int spin_wait(sem_t *sem, int timeout_sec, wait_stats_t *stats) {
+	unsigned int spin_us = spin_wait_budget_us();
+	unsigned long long start = (stats != NULL || spin_us > 0) ? now_ns() : 0;
+
+	int result = (spin_us > 0) ? spin(sem, start, spin_us) : -1;
+	bool spun = (result == 0);
+	unsigned long long spin_done = (stats != NULL && spin_us > 0) ? now_ns() : start;
+
+	if (!spun) {
+		if (timeout_sec > 0) {
+			struct timespec timeout;
+			clock_gettime(CLOCK_REALTIME, &timeout);
+			timeout.tv_sec += timeout_sec;
+			syscall_count(SYSCALL_SEM_TIMEDWAIT);
+			result = sem_timedwait(sem, &timeout);
+		}
+		else {
+			syscall_count(SYSCALL_SEM_WAIT);
+			result = sem_wait(sem);
+		}
+	}
+
+	if (stats != NULL) {
+		unsigned long long elapsed = now_ns() - start;
+		stats->spin_ns += spin_done - start;
+		if (result != 0) {
+			stats->timeouts++;
+			return result;
+		}
+		stats->waits++;
+		stats->spun += spun ? 1 : 0;
+		stats->blocked += spun ? 0 : 1;
+		stats->wait_ns += elapsed;
+		if (elapsed > stats->max_ns) {
+			stats->max_ns = elapsed;
+		}
+	}
+	return result;
+}
+
+int wait_stats_enabled(void) {
+	return getenv(WAIT_STATS_ENV) != NULL;
+}
+
+void print_wait_stats(FILE *out, const char *owner, const char *name, const wait_stats_t *stats) {
+	double average_us = stats->waits > 0 ? (double) stats->wait_ns / stats->waits / 1000.0 : 0.0;
+	double spun_pct = stats->waits > 0 ? 100.0 * stats->spun / stats->waits : 0.0;
+	fprintf(out,
+			"%s %s: %lu waits, %lu spun (%.1f%%), %lu blocked, %lu timeouts, avg %.1f us, max %.1f us, "
+			"spin %.1f ms\n",
+			owner, name, stats->waits, stats->spun, spun_pct, stats->blocked, stats->timeouts, average_us,
+			stats->max_ns / 1000.0, stats->spin_ns / 1000000.0);
+}
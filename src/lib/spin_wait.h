@@ -0,0 +1,63 @@
+#ifndef SPIN_WAIT_H
+#define SPIN_WAIT_H
+
+#include <semaphore.h>
+#include <stdio.h>
+
+/*
+ * Espera adaptativa sobre semaforos: primero se reintenta sem_trywait durante un tiempo corto (con la instruccion
+ * pause entre intentos) y recien despues se bloquea en el semaforo. Cuando el post llega enseguida, como en las
+ * esperas de turno con estrategias rapidas, se evita dormir y despertar al proceso.
+ *
+ * El tiempo de spin se toma de $CHOMP_SPIN_US (el master lo exporta con --spin). Sin la variable se usa
+ * SPIN_DEFAULT_US si hay mas de una CPU y 0 (bloqueo directo) si hay una sola, porque ahi el spin solo le quita
+ * tiempo al proceso que tiene que hacer el post.
+ */
+
+#define SPIN_ENV "CHOMP_SPIN_US"
+#define WAIT_STATS_ENV "CHOMP_WAIT_STATS" // Si esta definida, cada proceso imprime sus esperas al terminar
+#define SPIN_DEFAULT_US 50
+#define SPIN_MAX_US 100000
+#define SPIN_CHECK_INTERVAL 64 // Intentos entre lecturas del reloj
+
+// Estadisticas de un punto de espera
+typedef struct {
+	unsigned long waits;		// Esperas completadas
+	unsigned long spun;			// Esperas resueltas durante el spin
+	unsigned long blocked;		// Esperas que terminaron bloqueando en el semaforo
+	unsigned long timeouts;		// Esperas que vencieron (o fallaron)
+	unsigned long long spin_ns; // Tiempo total de spin
+	unsigned long long wait_ns; // Tiempo total de espera (spin + bloqueo)
+	unsigned long long max_ns;	// Espera mas larga
+} wait_stats_t;
+
+/**
+ * @brief Tiempo de spin del proceso (se calcula una vez)
+ * @return Microsegundos de spin antes de bloquear
+ */
+unsigned int spin_wait_budget_us(void);
+
+/**
+ * @brief Espera un semaforo girando primero y bloqueando despues
+ * @param sem Semaforo a esperar
+ * @param timeout_sec Tiempo maximo de espera en segundos (0: sin limite)
+ * @param stats Estadisticas a actualizar (puede ser NULL)
+ * @return 0 si se obtuvo el semaforo, -1 si vencio el timeout o hubo un error (errno como sem_wait)
+ */
+int spin_wait(sem_t *sem, int timeout_sec, wait_stats_t *stats);
+
+/**
+ * @brief Indica si hay que imprimir las estadisticas de espera ($CHOMP_WAIT_STATS)
+ */
+int wait_stats_enabled(void);
+
+/**
+ * @brief Imprime las estadisticas de un punto de espera
+ * @param out Stream de salida
+ * @param owner Proceso o jugador que espera
+ * @param name Nombre del semaforo
+ * @param stats Estadisticas acumuladas
+ */
+void print_wait_stats(FILE *out, const char *owner, const char *name, const wait_stats_t *stats);
+
+#endif // SPIN_WAIT_H
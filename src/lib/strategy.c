@@ -0,0 +1,156 @@
+// This is a personal academic project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: https://pvs-studio.com
+#define _GNU_SOURCE
+#include "strategy.h"
+#include "common.h"
+#include "player_functions.h"
+#include "territory.h"
+#include <dlfcn.h>
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+// Estrategias compiladas en player_functions.c y territory.c
+static const strategy_t *builtin_strategies[] = {&tornado_strategy, &random_strategy, &region_strategy,
+												 &territory_strategy};
+
+// Estrategias compiladas en un binario particular (por ejemplo player_mcts)
+static const strategy_t *registered_strategies[STRATEGY_MAX_REGISTERED];
+static int registered_count = 0;
+
+int strategy_register(const strategy_t *strategy) {
+	if (registered_count >= STRATEGY_MAX_REGISTERED) {
+		return -1;
+	}
+	registered_strategies[registered_count++] = strategy;
+	return 0;
+}
+
+/**
+ * @brief Intenta abrir un plugin y obtener su strategy_t
+ * @param path Ruta del objeto compartido
+ * @param instance Instancia donde guardar el handle y la estrategia
+ * @return 0 si se pudo cargar, -1 en caso contrario
+ */
+static int open_plugin(const char *path, strategy_instance_t *instance) {
+	void *library = dlopen(path, RTLD_NOW | RTLD_LOCAL);
+	if (library == NULL) {
+		return -1;
+	}
+
+	const strategy_t *strategy = dlsym(library, STRATEGY_SYMBOL);
+	if (strategy == NULL || strategy->abi_version < STRATEGY_MIN_ABI_VERSION ||
+		strategy->abi_version > STRATEGY_ABI_VERSION || strategy->choose_move == NULL) {
+		fprintf(stderr, "Error: %s does not export a valid %s (ABI %d-%d)\n", path, STRATEGY_SYMBOL,
+				STRATEGY_MIN_ABI_VERSION, STRATEGY_ABI_VERSION);
+		dlclose(library);
+		return -1;
+	}
+
+	instance->library = library;
+	instance->strategy = strategy;
+	return 0;
+}
+
+/**
+ * @brief Busca un plugin por nombre en $CHOMP_STRATEGY_PATH y en strategies/ junto al ejecutable
+ * @param name Nombre del plugin (sin extension)
+ * @param instance Instancia donde guardar el handle y la estrategia
+ * @return 0 si se encontro, -1 en caso contrario
+ */
+static int find_plugin(const char *name, strategy_instance_t *instance) {
+	char path[PATH_MAX];
+
+	const char *env_dir = getenv(STRATEGY_PATH_ENV);
+	if (env_dir != NULL) {
+		int written = snprintf(path, sizeof(path), "%s/%s%s", env_dir, name, STRATEGY_EXTENSION);
+		if (written > 0 && (size_t) written < sizeof(path) && open_plugin(path, instance) == 0)
+			return 0;
+	}
+
+	char exe_path[PATH_MAX];
+	ssize_t length = readlink("/proc/self/exe", exe_path, sizeof(exe_path) - 1);
+	if (length > 0) {
+		exe_path[length] = '\0';
+		char *slash = strrchr(exe_path, '/');
+		if (slash != NULL) {
+			*slash = '\0';
+			int written = snprintf(path, sizeof(path), "%s/%s/%s%s", exe_path, STRATEGY_DIR, name, STRATEGY_EXTENSION);
+			if (written > 0 && (size_t) written < sizeof(path) && open_plugin(path, instance) == 0)
+				return 0;
+		}
+	}
+
+	return -1;
+}
+
+int strategy_load(const char *name, int player_id, const game_state_t *state, strategy_instance_t *instance) {
+	memset(instance, 0, sizeof(*instance));
+	instance->player_id = player_id;
+
+	for (size_t i = 0; i < sizeof(builtin_strategies) / sizeof(builtin_strategies[0]); i++) {
+		if (strcmp(builtin_strategies[i]->name, name) == 0) {
+			instance->strategy = builtin_strategies[i];
+			break;
+		}
+	}
+
+	for (int i = 0; instance->strategy == NULL && i < registered_count; i++) {
+		if (strcmp(registered_strategies[i]->name, name) == 0) {
+			instance->strategy = registered_strategies[i];
+		}
+	}
+
+	if (instance->strategy == NULL) {
+		int result = (strchr(name, '/') != NULL) ? open_plugin(name, instance) : find_plugin(name, instance);
+		if (result != 0) {
+			fprintf(stderr, "Error: could not load strategy '%s'\n", name);
+			return -1;
+		}
+	}
+
+	if (instance->strategy->init != NULL) {
+		instance->data = instance->strategy->init(player_id, state);
+	}
+	return 0;
+}
+
+void strategy_attach_analytics(strategy_instance_t *instance, const struct game_analytics *analytics) {
+	// Antes de la version 3 el campo no existe en el plugin
+	if (analytics == NULL || instance->strategy->abi_version < 3 || instance->strategy->attach_analytics == NULL) {
+		return;
+	}
+	instance->strategy->attach_analytics(instance->data, analytics);
+}
+
+bool strategy_observe(strategy_instance_t *instance, const game_state_t *state) {
+	if (instance->strategy->on_state == NULL) {
+		return false;
+	}
+	instance->strategy->on_state(instance->data, instance->player_id, state);
+	return true;
+}
+
+direction_t strategy_choose_move(strategy_instance_t *instance, const game_state_t *state) {
+	return instance->strategy->choose_move(instance->data, instance->player_id, state);
+}
+
+unsigned int strategy_dependency_radius(const strategy_instance_t *instance) {
+	// En la version 1 el campo no existe en el plugin
+	if (instance->strategy->abi_version < 2 || instance->strategy->on_state != NULL) {
+		return 0;
+	}
+	return instance->strategy->dependency_radius;
+}
+
+void strategy_unload(strategy_instance_t *instance) {
+	if (instance->strategy != NULL && instance->strategy->destroy != NULL) {
+		instance->strategy->destroy(instance->data);
+	}
+	if (instance->library != NULL) {
+		dlclose(instance->library);
+	}
+	memset(instance, 0, sizeof(*instance));
+}
@@ -0,0 +1,130 @@
+#ifndef STRATEGY_H
+#define STRATEGY_H
+
+#include "common.h"
+
+/*
+ * ABI de estrategias de jugador.
+ *
+ * Una estrategia es un strategy_t con cuatro funciones. Las estrategias incluidas (tornado, random, region,
+ * territory) estan compiladas en player_functions.c y territory.c; cualquier otra se carga con dlopen desde un objeto
+ * compartido que exporta una variable strategy_t llamada STRATEGY_SYMBOL. La misma estrategia corre sin cambios en un
+ * proceso player, en un thread del master (--threads) o en cualquier otro runner que llame a estas funciones.
+ */
+
+#define STRATEGY_ABI_VERSION 3
+#define STRATEGY_MIN_ABI_VERSION 1 // Los plugins de la version 1 no declaran dependency_radius
+#define STRATEGY_SYMBOL "chomp_strategy"
+#define STRATEGY_PATH_ENV "CHOMP_STRATEGY_PATH"
+#define STRATEGY_DIR "strategies"
+#define STRATEGY_EXTENSION ".so"
+#define STRATEGY_MAX_REGISTERED 8
+
+typedef struct {
+	unsigned int abi_version; // Debe ser STRATEGY_ABI_VERSION
+	const char *name;		  // Nombre de la estrategia
+
+	/**
+	 * Crea el estado privado de la estrategia (se llama una vez, con el estado del juego tomado como lector).
+	 * Puede devolver NULL si la estrategia no necesita estado. Opcional.
+	 */
+	void *(*init)(int player_id, const game_state_t *state);
+
+	/**
+	 * Elige el proximo movimiento. Obligatoria. Se llama con el lock de lectura ya liberado.
+	 * Si la estrategia define on_state debe usar la copia privada tomada ahi; si no, state es una copia privada del
+	 * estado tomada por quien llama en este mismo turno.
+	 */
+	direction_t (*choose_move)(void *data, int player_id, const game_state_t *state);
+
+	/**
+	 * Observa el estado del juego en cada turno, con el lock de lectura tomado, antes de choose_move. Sirve para
+	 * copiar solo lo que la estrategia necesita (por ejemplo actualizaciones incrementales) en lugar de que quien
+	 * llama copie el estado completo. Opcional.
+	 */
+	void (*on_state)(void *data, int player_id, const game_state_t *state);
+
+	/**
+	 * Libera el estado privado creado por init. Opcional.
+	 */
+	void (*destroy)(void *data);
+
+	/**
+	 * Radio (en celdas alrededor de la posicion del jugador) del que depende choose_move, o 0 si depende de todo el
+	 * tablero o de estado interno. Con un radio > 0 (y sin on_state) el jugador calcula el proximo movimiento
+	 * mientras espera su turno y lo descarta si cambio alguna celda de ese radio, asi que choose_move debe tolerar
+	 * llamadas cuyo resultado no se usa. Desde la version 2 del ABI.
+	 */
+	unsigned int dependency_radius;
+
+	/**
+	 * Recibe el segmento de analisis del master (--analytics) una vez, despues de init y antes del primer turno.
+	 * No se llama si el master no lo publica. El segmento es de solo lectura y se escribe sin locks: hay que leerlo
+	 * con analytics_read_summary o analytics_read_regions (analytics.h). Opcional. Desde la version 3 del ABI.
+	 */
+	void (*attach_analytics)(void *data, const struct game_analytics *analytics);
+} strategy_t;
+
+// Estrategia cargada para un jugador
+typedef struct {
+	const strategy_t *strategy; // Funciones de la estrategia
+	void *data;					// Estado privado devuelto por init
+	void *library;				// Handle de dlopen (NULL para estrategias incluidas)
+	int player_id;				// Jugador que usa la estrategia
+} strategy_instance_t;
+
+/**
+ * @brief Registra una estrategia compilada en el binario para que strategy_load la encuentre por nombre
+ * @param strategy Estrategia a registrar (debe vivir durante todo el programa)
+ * @return 0 si se registro, -1 si no hay lugar
+ */
+int strategy_register(const strategy_t *strategy);
+
+/**
+ * @brief Carga una estrategia por nombre e inicializa su estado
+ * @param name Nombre de una estrategia incluida, nombre de un plugin o ruta a un objeto compartido
+ * @param player_id ID del jugador
+ * @param state Estado del juego (tomado como lector por quien llama)
+ * @param instance Puntero a la instancia a llenar
+ * @return 0 si la carga fue exitosa, -1 en caso de error
+ * @details Los plugins se buscan en $CHOMP_STRATEGY_PATH y luego en el directorio strategies/ junto al ejecutable.
+ */
+int strategy_load(const char *name, int player_id, const game_state_t *state, strategy_instance_t *instance);
+
+/**
+ * @brief Pasa el segmento de analisis a la estrategia si lo usa
+ * @param instance Instancia cargada
+ * @param analytics Segmento de analisis (NULL si el master no lo publica: no se llama a la estrategia)
+ */
+void strategy_attach_analytics(strategy_instance_t *instance, const struct game_analytics *analytics);
+
+/**
+ * @brief Informa el estado actual a la estrategia (llamar con el lock de lectura tomado)
+ * @param instance Instancia cargada
+ * @param state Estado del juego
+ * @return true si la estrategia tomo su propia copia (quien llama no necesita copiar el estado)
+ */
+bool strategy_observe(strategy_instance_t *instance, const game_state_t *state);
+
+/**
+ * @brief Obtiene el movimiento elegido por la estrategia
+ * @param instance Instancia cargada
+ * @param state Estado del juego
+ * @return Movimiento elegido
+ */
+direction_t strategy_choose_move(strategy_instance_t *instance, const game_state_t *state);
+
+/**
+ * @brief Radio de dependencia para precalcular movimientos
+ * @param instance Instancia cargada
+ * @return dependency_radius, o 0 si la estrategia no admite especulacion (ABI 1 o con on_state)
+ */
+unsigned int strategy_dependency_radius(const strategy_instance_t *instance);
+
+/**
+ * @brief Libera el estado de la estrategia y descarga el plugin
+ * @param instance Instancia cargada
+ */
+void strategy_unload(strategy_instance_t *instance);
+
+#endif // STRATEGY_H
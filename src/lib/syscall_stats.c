@@ -0,0 +1,134 @@
+// This is a personal academic project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: https://pvs-studio.com
+#define _GNU_SOURCE
+#include "syscall_stats.h"
+#include "library.h"
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+static const char *kind_names[SYSCALL_KINDS] = {"select",   "read",     "write",  "sem_wait", "sem_try",
+												"sem_timed", "sem_post", "usleep", "waitid",   "kill"};
+
+// Sin segmento cada thread cuenta en el lugar local (en el modo con threads los jugadores tienen el suyo)
+static syscall_slot_t local_slot;
+static __thread syscall_slot_t *current_slot = &local_slot;
+
+void syscall_count(syscall_kind_t kind) {
+	__atomic_fetch_add(&current_slot->counts[kind], 1, __ATOMIC_RELAXED);
+}
+
+void syscall_stats_attach(syscall_slot_t *slot) {
+	current_slot = (slot != NULL) ? slot : &local_slot;
+	current_slot->pid = getpid();
+}
+
+int syscall_stats_create(game_syscalls_t **stats, bool shared) {
+	if (!shared) {
+		*stats = calloc(1, sizeof(game_syscalls_t));
+		if (*stats == NULL)
+			return -1;
+		syscall_stats_attach(&(*stats)->slots[0]);
+		return 0;
+	}
+
+	int fd = shm_open(shm_name(GAME_SYSCALLS_SHM), O_CREAT | O_RDWR | O_EXCL, 0666);
+	if (fd == -1) {
+		perror("Error creating syscall stats shared memory");
+		return -1;
+	}
+	if (ftruncate(fd, sizeof(game_syscalls_t)) == -1) {
+		perror("Error setting syscall stats size");
+		close(fd);
+		shm_unlink(shm_name(GAME_SYSCALLS_SHM));
+		return -1;
+	}
+
+	*stats = mmap(NULL, sizeof(game_syscalls_t), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+	close(fd);
+	if (*stats == MAP_FAILED) {
+		perror("Error mapping syscall stats");
+		*stats = NULL;
+		shm_unlink(shm_name(GAME_SYSCALLS_SHM));
+		return -1;
+	}
+	syscall_stats_attach(&(*stats)->slots[0]);
+	return 0;
+}
+
+void syscall_stats_connect(int slot) {
+	int fd = shm_open(shm_name(GAME_SYSCALLS_SHM), O_RDWR, 0);
+	if (fd == -1)
+		return;
+
+	// El mapeo se mantiene hasta que el proceso termina
+	game_syscalls_t *stats = mmap(NULL, sizeof(game_syscalls_t), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+	close(fd);
+	if (stats != MAP_FAILED) {
+		syscall_stats_attach(&stats->slots[slot]);
+	}
+}
+
+void syscall_stats_destroy(game_syscalls_t **stats, bool shared) {
+	if (*stats == NULL)
+		return;
+
+	syscall_stats_attach(NULL);
+	if (shared) {
+		munmap(*stats, sizeof(game_syscalls_t));
+		shm_unlink(shm_name(GAME_SYSCALLS_SHM));
+	}
+	else {
+		free(*stats);
+	}
+	*stats = NULL;
+}
+
+/**
+ * @brief Imprime una fila con cada contador dividido por la cantidad de movimientos
+ */
+static void print_row(const char *name, const unsigned long long counts[SYSCALL_KINDS], unsigned long long moves) {
+	printf("%-8s", name);
+	for (int kind = 0; kind < SYSCALL_KINDS; kind++) {
+		printf(" %9.2f", moves > 0 ? (double) counts[kind] / moves : 0.0);
+	}
+	printf("\n");
+}
+
+void syscall_stats_print(const game_syscalls_t *stats, int player_count, unsigned long long moves) {
+	printf("\n=== SYSCALLS PER MOVE (%llu moves) ===\n", moves);
+	printf("%-8s", "Process");
+	for (int kind = 0; kind < SYSCALL_KINDS; kind++) {
+		printf(" %9s", kind_names[kind]);
+	}
+	printf("\n");
+
+	unsigned long long total[SYSCALL_KINDS] = {0};
+	for (int slot = 0; slot < SYSCALL_SLOTS; slot++) {
+		const syscall_slot_t *counts = &stats->slots[slot];
+		if (counts->pid == 0 || (slot > player_count && slot != SYSCALL_VIEW_SLOT))
+			continue;
+
+		char name[16];
+		if (slot == 0) {
+			snprintf(name, sizeof(name), "master");
+		}
+		else if (slot == SYSCALL_VIEW_SLOT) {
+			snprintf(name, sizeof(name), "view");
+		}
+		else {
+			snprintf(name, sizeof(name), "P%d", slot);
+		}
+
+		unsigned long long snapshot[SYSCALL_KINDS];
+		for (int kind = 0; kind < SYSCALL_KINDS; kind++) {
+			snapshot[kind] = __atomic_load_n(&counts->counts[kind], __ATOMIC_RELAXED);
+			total[kind] += snapshot[kind];
+		}
+		print_row(name, snapshot, moves);
+	}
+	print_row("total", total, moves);
+	printf("=====================================\n");
+}
@@ -0,0 +1,89 @@
+#ifndef SYSCALL_STATS_H
+#define SYSCALL_STATS_H
+
+#include "common.h"
+
+/*
+ * Contadores de llamadas al sistema en el camino caliente (--syscalls).
+ *
+ * Cada sitio del protocolo (select, read/write de los pipes, sem_*, usleep y waitid/kill de is_process_alive) llama
+ * a syscall_count justo antes de la llamada: un incremento atomico relajado sobre el lugar del thread actual, sin
+ * perturbar los tiempos como strace. Sin --syscalls los contadores van a un lugar local que nadie lee.
+ *
+ * Con --syscalls el master crea GAME_SYSCALLS_SHM con un lugar por proceso (0 el master, 1..9 los jugadores y
+ * SYSCALL_VIEW_SLOT la vista) y al final imprime cada contador dividido por la cantidad de movimientos procesados.
+ * Las sem_* cuentan llamadas a la libreria: sem_trywait y sem_post sin esperas no entran al kernel. sem_try cuenta
+ * las esperas que pasaron por el spin (una por espera, no por reintento).
+ */
+
+#define GAME_SYSCALLS_SHM "/game_syscalls"
+#define SYSCALL_VIEW_SLOT (MAX_PLAYERS + 1)
+#define SYSCALL_SLOTS (MAX_PLAYERS + 2)
+
+typedef enum {
+	SYSCALL_SELECT = 0,
+	SYSCALL_READ,
+	SYSCALL_WRITE,
+	SYSCALL_SEM_WAIT,
+	SYSCALL_SEM_TRYWAIT,
+	SYSCALL_SEM_TIMEDWAIT,
+	SYSCALL_SEM_POST,
+	SYSCALL_USLEEP,
+	SYSCALL_WAITID,
+	SYSCALL_KILL,
+	SYSCALL_KINDS
+} syscall_kind_t;
+
+// Lugar de un proceso (o thread en el modo con threads)
+typedef struct {
+	pid_t pid;								  // Proceso que usa el lugar (0 si no se uso)
+	unsigned long long counts[SYSCALL_KINDS]; // Llamadas de cada tipo
+} syscall_slot_t;
+
+// Segmento compartido
+typedef struct game_syscalls {
+	syscall_slot_t slots[SYSCALL_SLOTS];
+} game_syscalls_t;
+
+/**
+ * @brief Cuenta una llamada en el lugar del thread actual
+ * @param kind Tipo de llamada
+ */
+void syscall_count(syscall_kind_t kind);
+
+/**
+ * @brief Hace que el thread actual cuente en un lugar
+ * @param slot Lugar (NULL: vuelve al lugar local)
+ */
+void syscall_stats_attach(syscall_slot_t *slot);
+
+/**
+ * @brief Crea el segmento (master) y pasa a contar en el lugar 0
+ * @param stats Puntero para almacenar el segmento
+ * @param shared true para crearlo en memoria compartida, false para memoria privada (--threads)
+ * @return 0 si la creacion fue exitosa, -1 en caso de error
+ */
+int syscall_stats_create(game_syscalls_t **stats, bool shared);
+
+/**
+ * @brief Conecta el proceso a su lugar si el master cuenta llamadas
+ * @param slot Lugar del proceso (player_id + 1 o SYSCALL_VIEW_SLOT)
+ */
+void syscall_stats_connect(int slot);
+
+/**
+ * @brief Libera el segmento (master)
+ * @param stats Puntero al segmento (se pone en NULL)
+ * @param shared Si fue creado en memoria compartida
+ */
+void syscall_stats_destroy(game_syscalls_t **stats, bool shared);
+
+/**
+ * @brief Imprime las llamadas de cada proceso por movimiento procesado
+ * @param stats Segmento
+ * @param player_count Cantidad de jugadores
+ * @param moves Movimientos procesados por el master
+ */
+void syscall_stats_print(const game_syscalls_t *stats, int player_count, unsigned long long moves);
+
+#endif // SYSCALL_STATS_H
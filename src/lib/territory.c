@@ -0,0 +1,600 @@
+// This is a personal academic project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: https://pvs-studio.com
+#include "territory.h"
+#include "common.h"
+#include "engine.h"
+#include <stdlib.h>
+#include <string.h>
+
+#define ROW(bits, territory, y) ((bits) + (size_t) (y) * (territory)->words)
+
+static bool is_free(const territory_t *territory, int x, int y) {
+	if (x < 0 || y < 0 || x >= territory->width || y >= territory->height)
+		return false;
+	return (ROW(territory->free_cells, territory, y)[x / 64] >> (x % 64)) & 1;
+}
+
+static int min_int(int a, int b) {
+	return (a < b) ? a : b;
+}
+
+static int max_int(int a, int b) {
+	return (a > b) ? a : b;
+}
+
+// Filas de la capa k de un campo, recortadas al tablero
+static int layer_low(const territory_field_t *field, int k) {
+	return max_int(field->y - k, 0);
+}
+
+static int layer_high(const territory_t *territory, const territory_field_t *field, int k) {
+	return min_int(field->y + k, territory->height - 1);
+}
+
+static uint64_t *layer_base(const territory_t *territory, const territory_field_t *field, int k) {
+	return field->layers + territory->layer_offset[k];
+}
+
+static uint64_t *layer_row(const territory_t *territory, const territory_field_t *field, int k, int y) {
+	return layer_base(territory, field, k) + (size_t) (y - layer_low(field, k)) * territory->words;
+}
+
+static bool layer_has(const territory_t *territory, const territory_field_t *field, int k, int x, int y) {
+	if (y < layer_low(field, k) || y > layer_high(territory, field, k))
+		return false;
+	return (layer_row(territory, field, k, y)[x / 64] >> (x % 64)) & 1;
+}
+
+int territory_create(territory_t *territory, int width, int height, int radius) {
+	memset(territory, 0, sizeof(*territory));
+	territory->width = width;
+	territory->height = height;
+	territory->words = (width + 63) / 64;
+	territory->radius = radius;
+	territory->rivals_for = -1;
+
+	// La capa k ocupa a lo sumo 2k + 1 filas
+	size_t words = (size_t) territory->words * height;
+	size_t field_words = 0;
+	bool ok = (territory->layer_offset = malloc((size_t) (territory->radius + 1) * sizeof(size_t))) != NULL;
+	for (int k = 0; ok && k <= territory->radius; k++) {
+		territory->layer_offset[k] = field_words;
+		field_words += (size_t) min_int(2 * k + 1, height) * territory->words;
+	}
+	size_t layer_words = (size_t) min_int(2 * territory->radius + 1, height) * territory->words;
+
+	ok = ok && (territory->rewards = malloc((size_t) width * height)) != NULL;
+	ok = ok && (territory->free_cells = calloc(words, sizeof(uint64_t))) != NULL;
+	ok = ok && (territory->layer = calloc(layer_words, sizeof(uint64_t))) != NULL;
+	ok = ok && (territory->claimed = calloc(words, sizeof(uint64_t))) != NULL;
+	ok = ok && (territory->seen = calloc(words, sizeof(uint64_t))) != NULL;
+	ok = ok && (territory->contested = calloc(words, sizeof(uint64_t))) != NULL;
+	ok = ok && (territory->spread = calloc(words, sizeof(uint64_t))) != NULL;
+	ok = ok && (territory->rival_distance = malloc((size_t) width * height * sizeof(int))) != NULL;
+	ok = ok && (territory->rival_owner = malloc((size_t) width * height)) != NULL;
+	ok = ok && (territory->probe.layers = malloc(field_words * sizeof(uint64_t))) != NULL;
+	for (int i = 0; ok && i < MAX_PLAYERS; i++) {
+		ok = (territory->fields[i].layers = malloc(field_words * sizeof(uint64_t))) != NULL;
+	}
+
+	if (!ok) {
+		territory_destroy(territory);
+		return -1;
+	}
+	return 0;
+}
+
+void territory_destroy(territory_t *territory) {
+	free(territory->layer_offset);
+	free(territory->rewards);
+	free(territory->free_cells);
+	free(territory->layer);
+	free(territory->claimed);
+	free(territory->seen);
+	free(territory->contested);
+	free(territory->spread);
+	free(territory->rival_distance);
+	free(territory->rival_owner);
+	free(territory->probe.layers);
+	for (int i = 0; i < MAX_PLAYERS; i++) {
+		free(territory->fields[i].layers);
+	}
+	memset(territory, 0, sizeof(*territory));
+}
+
+/**
+ * @brief Dilata una fila un lugar a izquierda y derecha (incluye las diagonales al combinar filas vecinas)
+ */
+static void spread_row(const uint64_t *row, uint64_t *out, int words) {
+	for (int i = 0; i < words; i++) {
+		uint64_t word = row[i];
+		uint64_t left = (word << 1) | (i > 0 ? row[i - 1] >> 63 : 0);
+		uint64_t right = (word >> 1) | (i + 1 < words ? row[i + 1] << 63 : 0);
+		out[i] = word | left | right;
+	}
+}
+
+/**
+ * @brief Calcula la capa k + 1 de un campo: vecinos libres de la capa k que no estan en las capas k ni k - 1
+ * @param out Filas de la capa k + 1 (con la misma disposicion que dentro del campo)
+ * @return true si la capa no quedo vacia
+ */
+static bool next_layer(territory_t *territory, const territory_field_t *field, int k, uint64_t *out) {
+	int words = territory->words;
+	int low = layer_low(field, k), high = layer_high(territory, field, k);
+	for (int y = low; y <= high; y++) {
+		spread_row(layer_row(territory, field, k, y), ROW(territory->spread, territory, y), words);
+	}
+
+	bool any = false;
+	int next_low = layer_low(field, k + 1), next_high = layer_high(territory, field, k + 1);
+	for (int y = next_low; y <= next_high; y++) {
+		uint64_t *next = out + (size_t) (y - next_low) * words;
+		const uint64_t *free_row = ROW(territory->free_cells, territory, y);
+		const uint64_t *current = (y >= low && y <= high) ? layer_row(territory, field, k, y) : NULL;
+		const uint64_t *previous = (k > 0 && y >= layer_low(field, k - 1) && y <= layer_high(territory, field, k - 1))
+									   ? layer_row(territory, field, k - 1, y)
+									   : NULL;
+		for (int i = 0; i < words; i++) {
+			uint64_t bits = 0;
+			for (int dy = -1; dy <= 1; dy++) {
+				if (y + dy >= low && y + dy <= high)
+					bits |= ROW(territory->spread, territory, y + dy)[i];
+			}
+			bits &= free_row[i];
+			if (current != NULL)
+				bits &= ~current[i];
+			if (previous != NULL)
+				bits &= ~previous[i];
+			next[i] = bits;
+			any = any || bits != 0;
+		}
+	}
+	return any;
+}
+
+/**
+ * @brief Calcula desde cero el campo de distancias de una posicion
+ */
+static void build_field(territory_t *territory, territory_field_t *field, int x, int y) {
+	field->x = x;
+	field->y = y;
+	memset(layer_base(territory, field, 0), 0, territory->words * sizeof(uint64_t));
+	layer_row(territory, field, 0, y)[x / 64] |= (uint64_t) 1 << (x % 64);
+	field->depth = 1;
+	while (field->depth <= territory->radius &&
+		   next_layer(territory, field, field->depth - 1, layer_base(territory, field, field->depth))) {
+		field->depth++;
+	}
+	territory->field_builds++;
+}
+
+/**
+ * @brief Capa en la que esta una celda (la distancia de Chebyshev es una cota inferior)
+ * @return Indice de la capa, o -1 si la celda esta fuera del campo
+ */
+static int layer_of(const territory_t *territory, const territory_field_t *field, int x, int y) {
+	int dx = abs(x - field->x), dy = abs(y - field->y);
+	for (int k = max_int(dx, dy); k < field->depth; k++) {
+		if (layer_has(territory, field, k, x, y))
+			return k;
+	}
+	return -1;
+}
+
+/**
+ * @brief Corrige un campo despues de que se ocupo una celda (el bitset de libres ya esta actualizado)
+ * @details Las capas anteriores a la distancia d de la celda no cambian, y la capa d solo pierde la celda ocupada.
+ * Desde d se vuelven a dilatar las capas y se corta cuando dos consecutivas coinciden con las anteriores: las
+ * siguientes dependen solo de esas dos. Como la celda ocupada ya no puede aparecer en ninguna capa, la capa d cuenta
+ * como igual y alcanza con que coincida la d + 1.
+ */
+static void repair_field(territory_t *territory, territory_field_t *field, int x, int y) {
+	int d = layer_of(territory, field, x, y);
+	if (d <= 0)
+		return;
+	layer_row(territory, field, d, y)[x / 64] &= ~((uint64_t) 1 << (x % 64));
+	territory->field_repairs++;
+
+	bool previous_equal = true;
+	for (int k = d; k < territory->radius; k++) {
+		bool any = next_layer(territory, field, k, territory->layer);
+		size_t size = (size_t) (layer_high(territory, field, k + 1) - layer_low(field, k + 1) + 1) *
+					  territory->words * sizeof(uint64_t);
+		uint64_t *stored = layer_base(territory, field, k + 1);
+		bool equal = (k + 1 < field->depth) ? memcmp(stored, territory->layer, size) == 0 : !any;
+
+		if (!any) {
+			field->depth = k + 1;
+			break;
+		}
+		if (!equal) {
+			memcpy(stored, territory->layer, size);
+			field->depth = max_int(field->depth, k + 2);
+		}
+		if (equal && previous_equal)
+			break;
+		previous_equal = equal;
+	}
+}
+
+/**
+ * @brief Cambia el estado de una celda y corrige los campos validos
+ * @details Las celdas solo se ocupan; si alguna se liberara (un estado inconsistente) se recalculan los campos.
+ */
+static void set_cell(territory_t *territory, int x, int y, bool occupied) {
+	uint64_t bit = (uint64_t) 1 << (x % 64);
+	uint64_t *word = &ROW(territory->free_cells, territory, y)[x / 64];
+	if (((*word & bit) == 0) == occupied)
+		return;
+	*word = occupied ? (*word & ~bit) : (*word | bit);
+
+	for (unsigned int p = 0; p < territory->player_count; p++) {
+		if (!occupied) {
+			territory->fields[p].depth = 0;
+		}
+		else if (territory->fields[p].depth > 0) {
+			repair_field(territory, &territory->fields[p], x, y);
+		}
+	}
+}
+
+/**
+ * @brief Carga las celdas libres y sus recompensas recorriendo un rectangulo del tablero
+ */
+static void load_area(territory_t *territory, const game_state_t *state, int x0, int y0, int x1, int y1) {
+	for (int y = y0; y <= y1; y++) {
+		for (int x = x0; x <= x1; x++) {
+			int value = state->board[y * territory->width + x];
+			if (value > 0) {
+				territory->rewards[y * territory->width + x] = (unsigned char) value;
+			}
+			set_cell(territory, x, y, value <= 0);
+		}
+	}
+}
+
+void territory_sync(territory_t *territory, const game_state_t *state) {
+	territory->player_count = state->player_count;
+	territory->rivals_for = -1;
+	bool full = !territory->loaded;
+
+	// Los campos de los jugadores que se movieron (o quedaron bloqueados) se recalculan al evaluar
+	for (unsigned int i = 0; i < state->player_count; i++) {
+		if (full || state->players[i].is_blocked || state->players[i].x != territory->x[i] ||
+			state->players[i].y != territory->y[i]) {
+			territory->fields[i].depth = 0;
+		}
+	}
+
+	// Las celdas nunca se liberan: solo hay que revisar la zona que cada jugador pudo recorrer
+	for (unsigned int i = 0; i < state->player_count && !full; i++) {
+		long moves = (long) state->players[i].valid_moves - territory->valid_moves[i];
+		if (moves <= 0)
+			continue;
+		if ((2 * moves + 1) * (2 * moves + 1) > (long) territory->width * territory->height / 4) {
+			full = true;
+			break;
+		}
+		int x0 = territory->x[i] - (int) moves, x1 = territory->x[i] + (int) moves;
+		int y0 = territory->y[i] - (int) moves, y1 = territory->y[i] + (int) moves;
+		load_area(territory, state, x0 < 0 ? 0 : x0, y0 < 0 ? 0 : y0,
+				  x1 >= territory->width ? territory->width - 1 : x1,
+				  y1 >= territory->height ? territory->height - 1 : y1);
+		territory->incremental_syncs++;
+	}
+
+	if (full) {
+		for (unsigned int i = 0; i < state->player_count; i++) {
+			territory->fields[i].depth = 0;
+		}
+		load_area(territory, state, 0, 0, territory->width - 1, territory->height - 1);
+		territory->loaded = true;
+		territory->full_syncs++;
+	}
+
+	for (unsigned int i = 0; i < state->player_count; i++) {
+		territory->x[i] = state->players[i].x;
+		territory->y[i] = state->players[i].y;
+		territory->blocked[i] = state->players[i].is_blocked;
+		territory->valid_moves[i] = state->players[i].valid_moves;
+	}
+}
+
+/**
+ * @brief Recalcula los campos invalidos de los jugadores no bloqueados (salvo el del jugador skip)
+ */
+static void ensure_fields(territory_t *territory, int skip) {
+	for (unsigned int p = 0; p < territory->player_count; p++) {
+		if ((int) p != skip && !territory->blocked[p] && territory->fields[p].depth == 0) {
+			build_field(territory, &territory->fields[p], territory->x[p], territory->y[p]);
+		}
+	}
+}
+
+/**
+ * @brief Asigna las celdas recorriendo las capas de todos los campos a la vez
+ * @param fields Campo de cada jugador (NULL si esta bloqueado)
+ */
+static void combine_fields(territory_t *territory, const territory_field_t *fields[], territory_result_t *result) {
+	memset(result, 0, sizeof(*result));
+
+	int words = territory->words;
+	int depth = 0, low = territory->height, high = -1;
+	for (unsigned int p = 0; p < territory->player_count; p++) {
+		if (fields[p] == NULL)
+			continue;
+		depth = max_int(depth, fields[p]->depth);
+		low = min_int(low, layer_low(fields[p], fields[p]->depth - 1));
+		high = max_int(high, layer_high(territory, fields[p], fields[p]->depth - 1));
+	}
+	if (high < 0)
+		return;
+	memset(ROW(territory->claimed, territory, low), 0, (size_t) (high - low + 1) * words * sizeof(uint64_t));
+
+	for (int k = 1; k < depth; k++) {
+		int step_low = territory->height, step_high = -1;
+		for (unsigned int p = 0; p < territory->player_count; p++) {
+			if (fields[p] != NULL && k < fields[p]->depth) {
+				step_low = min_int(step_low, layer_low(fields[p], k));
+				step_high = max_int(step_high, layer_high(territory, fields[p], k));
+			}
+		}
+		if (step_high < 0)
+			break;
+
+		// Celdas a las que llegan dos o mas jugadores con la misma distancia
+		size_t step_span = (size_t) (step_high - step_low + 1) * words * sizeof(uint64_t);
+		memset(ROW(territory->seen, territory, step_low), 0, step_span);
+		memset(ROW(territory->contested, territory, step_low), 0, step_span);
+		for (unsigned int p = 0; p < territory->player_count; p++) {
+			if (fields[p] == NULL || k >= fields[p]->depth)
+				continue;
+			for (int y = layer_low(fields[p], k); y <= layer_high(territory, fields[p], k); y++) {
+				const uint64_t *layer = layer_row(territory, fields[p], k, y);
+				uint64_t *seen = ROW(territory->seen, territory, y);
+				uint64_t *contested = ROW(territory->contested, territory, y);
+				for (int i = 0; i < words; i++) {
+					contested[i] |= seen[i] & layer[i];
+					seen[i] |= layer[i];
+				}
+			}
+		}
+
+		// Cada jugador se queda con las celdas que alcanzo solo y que nadie alcanzo antes
+		for (unsigned int p = 0; p < territory->player_count; p++) {
+			if (fields[p] == NULL || k >= fields[p]->depth)
+				continue;
+			for (int y = layer_low(fields[p], k); y <= layer_high(territory, fields[p], k); y++) {
+				const uint64_t *layer = layer_row(territory, fields[p], k, y);
+				const uint64_t *contested = ROW(territory->contested, territory, y);
+				const uint64_t *claimed = ROW(territory->claimed, territory, y);
+				for (int i = 0; i < words; i++) {
+					uint64_t mine = layer[i] & ~contested[i] & ~claimed[i];
+					result->cells[p] += (unsigned int) __builtin_popcountll(mine);
+					while (mine != 0) {
+						int bit = __builtin_ctzll(mine);
+						result->reward[p] += territory->rewards[(size_t) y * territory->width + i * 64 + bit];
+						mine &= mine - 1;
+					}
+				}
+			}
+		}
+
+		for (int y = step_low; y <= step_high; y++) {
+			uint64_t *claimed = ROW(territory->claimed, territory, y);
+			const uint64_t *seen = ROW(territory->seen, territory, y);
+			for (int i = 0; i < words; i++) {
+				claimed[i] |= seen[i];
+			}
+		}
+	}
+}
+
+void territory_evaluate(territory_t *territory, territory_result_t *result) {
+	ensure_fields(territory, -1);
+
+	const territory_field_t *fields[MAX_PLAYERS] = {NULL};
+	for (unsigned int p = 0; p < territory->player_count; p++) {
+		fields[p] = territory->blocked[p] ? NULL : &territory->fields[p];
+	}
+	combine_fields(territory, fields, result);
+}
+
+/**
+ * @brief Asigna las celdas solo entre los rivales de un jugador (se reutiliza para todos sus movimientos simulados)
+ * @details Guarda por celda la menor distancia de un rival (0 si ninguno la alcanza) y el rival que la tiene (-1 si
+ * esta disputada), y en territory->rivals el resultado de esa asignacion.
+ */
+static void assign_rivals(territory_t *territory, int player_id) {
+	territory_result_t *rivals = &territory->rivals;
+	memset(rivals, 0, sizeof(*rivals));
+	territory->rivals_for = player_id;
+
+	int low = territory->height, high = -1;
+	for (unsigned int p = 0; p < territory->player_count; p++) {
+		const territory_field_t *field = &territory->fields[p];
+		if ((int) p != player_id && !territory->blocked[p]) {
+			low = min_int(low, layer_low(field, field->depth - 1));
+			high = max_int(high, layer_high(territory, field, field->depth - 1));
+		}
+	}
+	territory->rivals_low = low;
+	territory->rivals_high = high;
+	if (high < 0)
+		return;
+	memset(territory->rival_distance + (size_t) low * territory->width, 0,
+		   (size_t) (high - low + 1) * territory->width * sizeof(int));
+
+	for (unsigned int p = 0; p < territory->player_count; p++) {
+		const territory_field_t *field = &territory->fields[p];
+		if ((int) p == player_id || territory->blocked[p])
+			continue;
+		for (int k = 1; k < field->depth; k++) {
+			for (int y = layer_low(field, k); y <= layer_high(territory, field, k); y++) {
+				const uint64_t *row = layer_row(territory, field, k, y);
+				for (int i = 0; i < territory->words; i++) {
+					for (uint64_t bits = row[i]; bits != 0; bits &= bits - 1) {
+						size_t cell = (size_t) y * territory->width + i * 64 + __builtin_ctzll(bits);
+						int distance = territory->rival_distance[cell];
+						if (distance == 0 || k < distance) {
+							territory->rival_distance[cell] = k;
+							territory->rival_owner[cell] = (signed char) p;
+						}
+						else if (k == distance) {
+							territory->rival_owner[cell] = -1;
+						}
+					}
+				}
+			}
+		}
+	}
+
+	for (int y = low; y <= high; y++) {
+		for (int x = 0; x < territory->width; x++) {
+			size_t cell = (size_t) y * territory->width + x;
+			int owner = territory->rival_owner[cell];
+			if (territory->rival_distance[cell] > 0 && owner >= 0) {
+				rivals->cells[owner]++;
+				rivals->reward[owner] += territory->rewards[cell];
+			}
+		}
+	}
+}
+
+/**
+ * @brief Distancia de los rivales a una celda (0 si ninguno la alcanza)
+ */
+static int rival_distance(const territory_t *territory, size_t cell) {
+	int y = (int) (cell / territory->width);
+	return (y < territory->rivals_low || y > territory->rivals_high) ? 0 : territory->rival_distance[cell];
+}
+
+void territory_evaluate_move(territory_t *territory, int player_id, int x, int y, territory_result_t *result) {
+	ensure_fields(territory, player_id);
+	if (territory->rivals_for != player_id) {
+		assign_rivals(territory, player_id);
+	}
+
+	// Se parte de la asignacion entre rivales y se le restan las celdas que el que mueve alcanza antes o empatado.
+	// Los campos de los rivales no se corrigen por la celda destino: solo cambiarian las distancias de celdas a las
+	// que un rival llegaba pasando por el destino, y a esas el que mueve llega antes de todos modos.
+	*result = territory->rivals;
+	size_t cell = (size_t) y * territory->width + x;
+	if (rival_distance(territory, cell) > 0 && territory->rival_owner[cell] >= 0) {
+		result->cells[territory->rival_owner[cell]]--;
+		result->reward[territory->rival_owner[cell]] -= territory->rewards[cell];
+	}
+
+	// BFS del que mueve desde el destino, que solo se expande por celdas a las que ningun rival llego antes: una celda
+	// que alcanza primero (o empatado) tiene todo un camino minimo de celdas que tambien alcanza primero o empatado
+	territory_field_t *probe = &territory->probe;
+	probe->x = x;
+	probe->y = y;
+	memset(layer_base(territory, probe, 0), 0, territory->words * sizeof(uint64_t));
+	layer_row(territory, probe, 0, y)[x / 64] |= (uint64_t) 1 << (x % 64);
+
+	for (int k = 1; k <= territory->radius; k++) {
+		probe->depth = k;
+		if (!next_layer(territory, probe, k - 1, layer_base(territory, probe, k)))
+			break;
+
+		bool any = false;
+		for (int row_y = layer_low(probe, k); row_y <= layer_high(territory, probe, k); row_y++) {
+			uint64_t *row = layer_row(territory, probe, k, row_y);
+			for (int i = 0; i < territory->words; i++) {
+				for (uint64_t bits = row[i]; bits != 0; bits &= bits - 1) {
+					int bit = __builtin_ctzll(bits);
+					cell = (size_t) row_y * territory->width + i * 64 + bit;
+					int distance = rival_distance(territory, cell);
+					if (distance != 0 && distance < k) {
+						row[i] &= ~((uint64_t) 1 << bit);
+						continue;
+					}
+					if (distance != 0 && territory->rival_owner[cell] >= 0) {
+						result->cells[territory->rival_owner[cell]]--;
+						result->reward[territory->rival_owner[cell]] -= territory->rewards[cell];
+					}
+					if (distance != k) {
+						result->cells[player_id]++;
+						result->reward[player_id] += territory->rewards[cell];
+					}
+				}
+				any = any || row[i] != 0;
+			}
+		}
+		if (!any)
+			break;
+	}
+}
+
+static void *territory_init(int player_id, const game_state_t *state) {
+	(void) player_id;
+	const char *env = getenv(TERRITORY_RADIUS_ENV);
+	int radius = (env != NULL && atoi(env) > 0) ? atoi(env) : TERRITORY_RADIUS;
+
+	territory_t *territory = malloc(sizeof(territory_t));
+	if (territory == NULL || territory_create(territory, state->width, state->height, radius) != 0) {
+		free(territory);
+		return NULL;
+	}
+	return territory;
+}
+
+static void territory_on_state(void *data, int player_id, const game_state_t *state) {
+	(void) player_id;
+	if (data != NULL) {
+		territory_sync(data, state);
+	}
+}
+
+static direction_t territory_choose_move(void *data, int player_id, const game_state_t *state) {
+	(void) state;
+	territory_t *territory = data;
+	if (territory == NULL)
+		return DIR_UP;
+
+	int x = territory->x[player_id];
+	int y = territory->y[player_id];
+	direction_t best_move = DIR_UP;
+	long best_score = 0;
+	int best_reward = -1;
+
+	// Se simula cada movimiento y se compara el territorio propio contra el del mejor rival
+	for (int dir = 0; dir < ENGINE_DIRECTIONS; dir++) {
+		int dx, dy;
+		engine_direction_offset((direction_t) dir, &dx, &dy);
+		int nx = x + dx, ny = y + dy;
+		if (!is_free(territory, nx, ny))
+			continue;
+
+		int reward = territory->rewards[ny * territory->width + nx];
+		territory_result_t result;
+		territory_evaluate_move(territory, player_id, nx, ny, &result);
+
+		unsigned int best_rival = 0;
+		for (unsigned int p = 0; p < territory->player_count; p++) {
+			if ((int) p != player_id && result.reward[p] > best_rival)
+				best_rival = result.reward[p];
+		}
+		long score = (long) reward + result.reward[player_id] - best_rival;
+
+		if (best_reward == -1 || score > best_score || (score == best_score && reward > best_reward)) {
+			best_score = score;
+			best_reward = reward;
+			best_move = (direction_t) dir;
+		}
+	}
+
+	return best_move;
+}
+
+static void territory_free(void *data) {
+	if (data != NULL) {
+		territory_destroy(data);
+		free(data);
+	}
+}
+
+const strategy_t territory_strategy = {STRATEGY_ABI_VERSION, TERRITORY_NAME, territory_init, territory_choose_move,
+									   territory_on_state, territory_free, 0, NULL};
@@ -0,0 +1,124 @@
+#ifndef TERRITORY_H
+#define TERRITORY_H
+
+#include "common.h"
+#include "strategy.h"
+#include <stdint.h>
+
+/*
+ * Evaluador de territorio (Voronoi por flood fill).
+ *
+ * Las celdas libres se guardan como un bitset por fila (64 celdas por palabra). Cada jugador tiene un campo de
+ * distancias guardado como capas del BFS: la capa k es el bitset de las celdas a distancia exacta k de su posicion, y
+ * se obtiene dilatando la capa k - 1 con shifts y OR de palabras enteras. Una celda es del jugador que la tiene en la
+ * capa mas baja; si dos o mas jugadores la tienen en la misma capa queda disputada. Asi se obtiene, para cada
+ * jugador, cuantas celdas y cuanta recompensa alcanza antes que cualquier rival.
+ *
+ * Los campos se actualizan de forma incremental: cuando se ocupa una celda solo se vuelven a dilatar las capas desde
+ * la distancia de esa celda, y se corta apenas una capa queda igual a la anterior. Solo se recalcula completo el
+ * campo de un jugador que cambio de posicion. Para simular los movimientos de un jugador se asignan una vez las
+ * celdas entre sus rivales, y cada movimiento solo recorre el BFS del que mueve (acotado a su territorio) restando lo
+ * que le quita a esa asignacion; los campos de los rivales se usan tal como estan, sin corregirlos por la celda
+ * destino.
+ *
+ * El bitset de celdas libres y las recompensas son privados del evaluador: se cargan una vez y despues solo se
+ * actualizan las celdas que ocuparon los jugadores desde la ultima observacion.
+ */
+
+#define TERRITORY_NAME "territory"
+#define TERRITORY_RADIUS 64 // Capas de cada campo (acota el costo y la memoria en tableros de 1000x1000)
+#define TERRITORY_RADIUS_ENV "CHOMP_TERRITORY_RADIUS"
+
+// Resultado de una evaluacion
+typedef struct {
+	unsigned int cells[MAX_PLAYERS];  // Celdas alcanzadas primero por cada jugador
+	unsigned int reward[MAX_PLAYERS]; // Recompensa de esas celdas
+} territory_result_t;
+
+// Campo de distancias de un jugador
+typedef struct {
+	uint64_t *layers; // Capas del BFS; la capa k guarda solo las filas que puede ocupar (y - k a y + k)
+	int x;			  // Origen (posicion del jugador)
+	int y;			  // Origen (posicion del jugador)
+	int depth;		  // Capas validas (la capa 0 es el origen); 0 si hay que recalcular el campo
+} territory_field_t;
+
+typedef struct {
+	int width;				 // Ancho del tablero
+	int height;				 // Alto del tablero
+	int words;				 // Palabras de 64 bits por fila
+	int radius;				 // Capas de cada campo (distancia maxima)
+	uint64_t *free_cells;	 // Bitset de celdas libres
+	unsigned char *rewards;	 // Recompensa de cada celda (valida solo si esta libre)
+	size_t *layer_offset;	 // Inicio de cada capa dentro de un campo (en palabras)
+	uint64_t *layer;		 // Capa recalculada durante una correccion (para compararla con la anterior)
+	uint64_t *claimed;		 // Celdas ya asignadas o disputadas en la evaluacion actual
+	uint64_t *seen;			 // Celdas alcanzadas en la capa actual
+	uint64_t *contested;	 // Celdas alcanzadas por mas de un jugador en la capa actual
+	uint64_t *spread;		 // Dilatacion horizontal de una fila de la capa
+	territory_field_t fields[MAX_PLAYERS]; // Campo de distancias de cada jugador
+	territory_field_t probe;			   // Campo del jugador que mueve en un movimiento simulado
+	int *rival_distance;				   // Menor distancia de un rival a cada celda (0 si ninguno la alcanza)
+	signed char *rival_owner;			   // Rival con la menor distancia a cada celda (-1 si esta disputada)
+	int rivals_low;						   // Filas validas de rival_distance
+	int rivals_high;					   // Filas validas de rival_distance
+	int rivals_for;						   // Jugador para el que se asigno entre rivales (-1 si hay que recalcular)
+	territory_result_t rivals;			   // Asignacion entre los rivales de rivals_for
+
+	unsigned int player_count;			   // Cantidad de jugadores
+	unsigned short x[MAX_PLAYERS];		   // Posicion x observada de cada jugador
+	unsigned short y[MAX_PLAYERS];		   // Posicion y observada de cada jugador
+	bool blocked[MAX_PLAYERS];			   // Jugadores bloqueados
+	unsigned int valid_moves[MAX_PLAYERS]; // Movimientos validos en la ultima observacion
+	bool loaded;						   // Si ya se hizo la carga completa
+	unsigned long full_syncs;			   // Cantidad de cargas completas
+	unsigned long incremental_syncs;	   // Cantidad de actualizaciones incrementales
+	unsigned long field_builds;			   // Campos calculados desde cero
+	unsigned long field_repairs;		   // Campos corregidos por una celda ocupada
+} territory_t;
+
+/**
+ * @brief Reserva los bitsets y los campos de distancias del evaluador
+ * @param territory Evaluador a inicializar
+ * @param width Ancho del tablero
+ * @param height Alto del tablero
+ * @param radius Capas de cada campo (la memoria de cada campo crece con radius^2 filas)
+ * @return 0 si la reserva fue exitosa, -1 en caso de error
+ */
+int territory_create(territory_t *territory, int width, int height, int radius);
+
+/**
+ * @brief Libera el evaluador
+ * @param territory Evaluador a liberar
+ */
+void territory_destroy(territory_t *territory);
+
+/**
+ * @brief Actualiza las celdas libres y las posiciones a partir del estado del juego
+ * @param territory Evaluador
+ * @param state Estado del juego (tomado como lector por quien llama)
+ * @details Solo revisa la zona que cada jugador pudo recorrer desde la ultima observacion; la primera vez (o si
+ * la zona es muy grande) recorre el tablero completo.
+ */
+void territory_sync(territory_t *territory, const game_state_t *state);
+
+/**
+ * @brief Calcula el territorio de cada jugador con las posiciones y celdas libres actuales del evaluador
+ * @param territory Evaluador
+ * @param result Resultado por jugador
+ */
+void territory_evaluate(territory_t *territory, territory_result_t *result);
+
+/**
+ * @brief Calcula el territorio de cada jugador si un jugador se moviera a una celda libre
+ * @param territory Evaluador (queda como estaba al volver)
+ * @param player_id Jugador que mueve
+ * @param x Celda destino
+ * @param y Celda destino
+ * @param result Resultado por jugador
+ */
+void territory_evaluate_move(territory_t *territory, int player_id, int x, int y, territory_result_t *result);
+
+extern const strategy_t territory_strategy;
+
+#endif // TERRITORY_H
@@ -0,0 +1,335 @@
+// This is a personal academic project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: https://pvs-studio.com
+#define _GNU_SOURCE
+#include "thread_mode.h"
+#include "analytics.h"
+#include "common.h"
+#include "game_logic.h"
+#include "library.h"
+#include "lock_stats.h"
+#include "mcts.h"
+#include "player_functions.h"
+#include "strategy.h"
+#include "syscall_stats.h"
+#include "trace.h"
+#include <errno.h>
+#include <limits.h>
+#include <pthread.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+// Jugador ejecutado como thread del master
+typedef struct {
+	player_context_t ctx;		  // Contexto del jugador (el mismo que usa player_main_loop)
+	const char *strategy;		  // Estrategia del jugador
+	pthread_t thread;			  // Thread del jugador
+	bool started;				  // Si el thread fue creado
+	bool pending;				  // Hay un movimiento sin procesar en el buzon
+	unsigned char move;			  // Movimiento en el buzon
+	struct thread_mode *mode;	  // Estado compartido del modo con threads
+	struct rusage usage;		  // Recursos consumidos por el thread (al terminar)
+	syscall_slot_t *syscall_slot; // Lugar en los contadores de llamadas (NULL sin --syscalls)
+} player_thread_t;
+
+struct thread_mode {
+	pthread_mutex_t mailbox_mutex;		  // Protege los buzones y pending_count
+	pthread_cond_t mailbox_cond;		  // Se señala cuando un jugador deja un movimiento
+	unsigned int pending_count;			  // Cantidad de buzones con movimiento pendiente
+	player_thread_t players[MAX_PLAYERS]; // Jugadores
+};
+
+/**
+ * @brief Reemplazo de send_move: deja el movimiento en el buzon del jugador
+ * @param arg Puntero al player_thread_t
+ * @param move Movimiento elegido
+ */
+static void post_move(void *arg, direction_t move) {
+	player_thread_t *player = arg;
+	struct thread_mode *mode = player->mode;
+
+	pthread_mutex_lock(&mode->mailbox_mutex);
+	player->move = (unsigned char) move;
+	if (!player->pending) {
+		player->pending = true;
+		mode->pending_count++;
+	}
+	pthread_cond_signal(&mode->mailbox_cond);
+	pthread_mutex_unlock(&mode->mailbox_mutex);
+}
+
+/**
+ * @brief Funcion de entrada de cada thread de jugador
+ * @param arg Puntero al player_thread_t
+ */
+static void *player_thread_main(void *arg) {
+	player_thread_t *player = arg;
+	syscall_stats_attach(player->syscall_slot);
+	player_main_loop(&player->ctx, player->strategy);
+	getrusage(RUSAGE_THREAD, &player->usage);
+	return NULL;
+}
+
+/**
+ * @brief Elige la estrategia de un jugador a partir de su especificacion en -p
+ * @param spec "binario[:estrategia]"; sin estrategia se usa la de player (tornado), player_random (random) o
+ * player_mcts (mcts)
+ * @return Nombre de la estrategia, o NULL si no se puede deducir
+ */
+static const char *resolve_strategy(const char *spec) {
+	char binary[PATH_MAX];
+	const char *strategy = split_player_spec(spec, binary, sizeof(binary));
+	if (strategy != NULL) {
+		return strategy;
+	}
+
+	const char *name = strrchr(binary, '/');
+	name = (name != NULL) ? name + 1 : binary;
+
+	if (strcmp(name, "player") == 0) {
+		return tornado_strategy.name;
+	}
+	if (strcmp(name, "player_random") == 0) {
+		return random_strategy.name;
+	}
+	if (strcmp(name, "player_mcts") == 0) {
+		return mcts_strategy.name;
+	}
+	return NULL;
+}
+
+int create_player_threads(master_context_t *ctx) {
+	struct thread_mode *mode = calloc(1, sizeof(struct thread_mode));
+	if (mode == NULL) {
+		perror("Error allocating memory for player threads");
+		return -1;
+	}
+
+	for (int i = 0; i < ctx->config.player_count; i++) {
+		mode->players[i].strategy = resolve_strategy(ctx->config.player_paths[i]);
+		if (mode->players[i].strategy == NULL) {
+			fprintf(stderr, "Error: --threads needs player, player_random, player_mcts or binary:strategy, got %s\n",
+					ctx->config.player_paths[i]);
+			free(mode);
+			return -1;
+		}
+	}
+
+	// mcts esta compilada en el master igual que en player_mcts
+	strategy_register(&mcts_strategy);
+
+	pthread_mutex_init(&mode->mailbox_mutex, NULL);
+	pthread_cond_init(&mode->mailbox_cond, NULL);
+	ctx->threads = mode;
+
+	// Las señales las atiende solo el thread del master
+	sigset_t blocked, previous;
+	sigemptyset(&blocked);
+	sigaddset(&blocked, SIGINT);
+	sigaddset(&blocked, SIGTERM);
+	pthread_sigmask(SIG_BLOCK, &blocked, &previous);
+
+	int result = 0;
+	for (int i = 0; i < ctx->config.player_count; i++) {
+		player_thread_t *player = &mode->players[i];
+		player->mode = mode;
+		player->ctx.game_state = ctx->game_state;
+		player->ctx.game_sync = ctx->game_sync;
+		player->ctx.state_fd = -1;
+		player->ctx.sync_fd = -1;
+		player->ctx.player_id = i;
+		player->ctx.send_move_fn = post_move;
+		player->ctx.send_move_arg = player;
+		player->ctx.analytics_fd = -1;
+		if (ctx->analytics != NULL) {
+			player->ctx.analytics = analytics_connect(ctx->config.width, ctx->config.height, &player->ctx.analytics_fd);
+		}
+		player->ctx.lock_slot = (ctx->lock_stats != NULL) ? &ctx->lock_stats->slots[i + 1] : NULL;
+		player->syscall_slot = (ctx->syscalls != NULL) ? &ctx->syscalls->slots[i + 1] : NULL;
+		if (ctx->trace != NULL) {
+			player->ctx.trace_ring = &ctx->trace->rings[i + 1];
+			player->ctx.trace_ring->pid = getpid();
+			snprintf(player->ctx.trace_ring->name, TRACE_NAME_LEN, "P%d %s", i + 1, ctx->game_state->players[i].name);
+		}
+
+		int error = pthread_create(&player->thread, NULL, player_thread_main, player);
+		if (error != 0) {
+			fprintf(stderr, "Error creating player thread: %s\n", strerror(error));
+			result = -1;
+			break;
+		}
+		player->started = true;
+	}
+
+	pthread_sigmask(SIG_SETMASK, &previous, NULL);
+
+	if (result != 0) {
+		join_player_threads(ctx);
+	}
+	return result;
+}
+
+/**
+ * @brief Procesa como maximo un movimiento pendiente, rotando entre jugadores igual que process_player_moves
+ * @param ctx Puntero al contexto del master
+ * @param current_player Jugador por el que empieza la rotacion
+ * @param last_valid_move Momento del ultimo movimiento valido
+ * @return true si se proceso un movimiento
+ */
+static bool process_thread_moves(master_context_t *ctx, int *current_player, time_t *last_valid_move) {
+	struct thread_mode *mode = ctx->threads;
+
+	for (int attempts = 0; attempts < ctx->config.player_count; attempts++) {
+		int player_id = (*current_player + attempts) % ctx->config.player_count;
+		player_thread_t *player = &mode->players[player_id];
+
+		pthread_mutex_lock(&mode->mailbox_mutex);
+		if (!player->pending) {
+			pthread_mutex_unlock(&mode->mailbox_mutex);
+			continue;
+		}
+		unsigned char move = player->move;
+		player->pending = false;
+		mode->pending_count--;
+		pthread_mutex_unlock(&mode->mailbox_mutex);
+
+		// Como con los pipes, los movimientos de jugadores bloqueados se descartan
+		if (ctx->game_state->players[player_id].is_blocked) {
+			continue;
+		}
+
+		apply_player_move(ctx, player_id, move, last_valid_move);
+		*current_player = (player_id + 1) % ctx->config.player_count;
+		return true;
+	}
+
+	return false;
+}
+
+/**
+ * @brief Con --rounds: toma los movimientos pendientes de los jugadores que todavia no movieron en la ronda y la
+ * aplica cuando esta completa
+ * @param ctx Puntero al contexto del master
+ * @param round Ronda en curso
+ * @param last_valid_move Momento del ultimo movimiento valido
+ * @return true si se aplico una ronda
+ */
+static bool process_thread_round(master_context_t *ctx, round_t *round, time_t *last_valid_move) {
+	struct thread_mode *mode = ctx->threads;
+
+	pthread_mutex_lock(&mode->mailbox_mutex);
+	for (int player_id = 0; player_id < ctx->config.player_count; player_id++) {
+		player_thread_t *player = &mode->players[player_id];
+		if (!player->pending || round->submitted[player_id])
+			continue;
+		player->pending = false;
+		mode->pending_count--;
+
+		// Como con los pipes, los movimientos de jugadores bloqueados se descartan
+		if (!ctx->game_state->players[player_id].is_blocked) {
+			round_add(round, player_id, player->move);
+		}
+	}
+	pthread_mutex_unlock(&mode->mailbox_mutex);
+
+	if (!round_complete(ctx, round))
+		return false;
+	apply_round(ctx, round, last_valid_move);
+	return true;
+}
+
+/**
+ * @brief Equivalente al select de game_loop: espera hasta un segundo a que haya algun movimiento pendiente
+ * @param mode Estado del modo con threads
+ * @return true si hay movimientos pendientes
+ */
+static bool wait_for_moves(struct thread_mode *mode) {
+	struct timespec deadline;
+	clock_gettime(CLOCK_REALTIME, &deadline);
+	deadline.tv_sec += 1;
+
+	pthread_mutex_lock(&mode->mailbox_mutex);
+	while (mode->pending_count == 0) {
+		if (pthread_cond_timedwait(&mode->mailbox_cond, &mode->mailbox_mutex, &deadline) == ETIMEDOUT) {
+			break;
+		}
+	}
+	bool ready = mode->pending_count > 0;
+	pthread_mutex_unlock(&mode->mailbox_mutex);
+
+	return ready;
+}
+
+void thread_game_loop(master_context_t *ctx) {
+	time_t last_valid_move = time(NULL);
+	int current_player = 0;
+	round_t round;
+	memset(&round, 0, sizeof(round));
+
+	while (!ctx->game_state->game_finished) {
+		// La espera de movimientos ocupa el lugar del select en la traza
+		unsigned long long span = trace_now(ctx->trace_ring);
+		bool ready = wait_for_moves(ctx->threads);
+		trace_span(ctx->trace_ring, TRACE_SELECT, span, TRACE_NO_ARG);
+		if (!ready) {
+			if (difftime(time(NULL), last_valid_move) >= ctx->config.timeout) {
+				// Timeout, finalizando programa
+				break;
+			}
+			continue;
+		}
+
+		bool movement_processed = ctx->config.rounds ? process_thread_round(ctx, &round, &last_valid_move)
+													 : process_thread_moves(ctx, &current_player, &last_valid_move);
+
+		// Verificar fin de juego despues de procesar movimientos
+		span = trace_now(ctx->trace_ring);
+		bool ended = check_game_end(ctx);
+		trace_span(ctx->trace_ring, TRACE_CHECK_END, span, TRACE_NO_ARG);
+		if (ended) {
+			finish_game(ctx);
+			break;
+		}
+
+		if (movement_processed && ctx->config.delay > 0) {
+			span = trace_now(ctx->trace_ring);
+			syscall_count(SYSCALL_USLEEP);
+			usleep(ctx->config.delay * 1000);
+			trace_span(ctx->trace_ring, TRACE_SLEEP, span, TRACE_NO_ARG);
+		}
+
+		// Timeout global del juego
+		if (time(NULL) - last_valid_move > ctx->config.timeout) {
+			finish_game(ctx);
+			break;
+		}
+	}
+}
+
+void join_player_threads(master_context_t *ctx) {
+	struct thread_mode *mode = ctx->threads;
+	if (mode == NULL)
+		return;
+
+	// Si el bucle termino por timeout los jugadores siguen esperando su turno
+	if (!ctx->game_state->game_finished) {
+		finish_game(ctx);
+	}
+
+	for (int i = 0; i < ctx->config.player_count; i++) {
+		if (mode->players[i].started) {
+			pthread_join(mode->players[i].thread, NULL);
+			ctx->player_usage[i] = mode->players[i].usage;
+			ctx->player_measured[i] = true;
+		}
+		analytics_disconnect(&mode->players[i].ctx.analytics, &mode->players[i].ctx.analytics_fd);
+	}
+
+	pthread_cond_destroy(&mode->mailbox_cond);
+	pthread_mutex_destroy(&mode->mailbox_mutex);
+	free(mode);
+	ctx->threads = NULL;
+}
@@ -0,0 +1,28 @@
+#ifndef THREAD_MODE_H
+#define THREAD_MODE_H
+
+#include "common.h"
+
+/**
+ * @brief Crea un thread por jugador que ejecuta player_main_loop sobre el estado privado del master
+ * @param ctx Puntero al contexto del master (con estado y sincronizacion ya inicializados)
+ * @return 0 si la creacion fue exitosa, -1 en caso de error
+ * @details La estrategia se toma de -p binario:estrategia, o de la estrategia por defecto de player/player_random.
+ */
+int create_player_threads(master_context_t *ctx);
+
+/**
+ * @brief Bucle principal del juego en el modo con threads
+ * @param ctx Puntero al contexto del master
+ * @details Mismas reglas de turnos y validacion que game_loop, pero los movimientos llegan por un buzon en memoria
+ * protegido por un mutex en lugar de pipes y select.
+ */
+void thread_game_loop(master_context_t *ctx);
+
+/**
+ * @brief Termina el juego si hace falta y espera a que terminen todos los threads de jugadores
+ * @param ctx Puntero al contexto del master
+ */
+void join_player_threads(master_context_t *ctx);
+
+#endif // THREAD_MODE_H
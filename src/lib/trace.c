@@ -0,0 +1,193 @@
+// This is a personal academic project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: https://pvs-studio.com
+#define _GNU_SOURCE
+#include "trace.h"
+#include "library.h"
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <time.h>
+#include <unistd.h>
+
+static const char *phase_names[TRACE_PHASES] = {
+	"select",	 "read",	  "validate", "execute_player_move", "check_game_end", "sync_with_view", "usleep",
+	"turn wait", "read lock", "strategy", "send_move",			 "wait",		   "render",		 "flush",
+};
+
+static const char *phase_category(trace_phase_t phase) {
+	if (phase < TRACE_TURN_WAIT)
+		return "master";
+	return (phase < TRACE_VIEW_WAIT) ? "player" : "view";
+}
+
+unsigned long long trace_now(const trace_ring_t *ring) {
+	if (ring == NULL)
+		return 0;
+
+	struct timespec now;
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return (unsigned long long) now.tv_sec * 1000000000ULL + (unsigned long long) now.tv_nsec;
+}
+
+void trace_span(trace_ring_t *ring, trace_phase_t phase, unsigned long long start, unsigned int arg) {
+	if (ring == NULL)
+		return;
+
+	unsigned long long duration = trace_now(ring) - start;
+	unsigned long long head = ring->head; // Solo este proceso escribe head
+	trace_event_t *event = &ring->events[head & (TRACE_RING_EVENTS - 1)];
+	event->start_ns = start;
+	event->duration_ns = (duration > 0xFFFFFFFFULL) ? 0xFFFFFFFFu : (unsigned int) duration;
+	event->phase = (unsigned int) phase;
+	event->arg = arg;
+
+	// El evento queda completo antes de que un lector vea el nuevo head
+	__atomic_store_n(&ring->head, head + 1, __ATOMIC_RELEASE);
+}
+
+int trace_create(master_context_t *ctx) {
+	if (ctx->config.threads) {
+		ctx->trace = calloc(1, sizeof(game_trace_t));
+		if (ctx->trace == NULL) {
+			perror("Error allocating trace rings");
+			return -1;
+		}
+	}
+	else {
+		int fd = shm_open(shm_name(GAME_TRACE_SHM), O_CREAT | O_RDWR | O_EXCL, 0666);
+		if (fd == -1) {
+			perror("Error creating trace shared memory");
+			return -1;
+		}
+		if (ftruncate(fd, sizeof(game_trace_t)) == -1) {
+			perror("Error setting trace size");
+			close(fd);
+			shm_unlink(shm_name(GAME_TRACE_SHM));
+			return -1;
+		}
+
+		ctx->trace = mmap(NULL, sizeof(game_trace_t), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+		close(fd);
+		if (ctx->trace == MAP_FAILED) {
+			perror("Error mapping trace");
+			ctx->trace = NULL;
+			shm_unlink(shm_name(GAME_TRACE_SHM));
+			return -1;
+		}
+	}
+
+	ctx->trace_ring = &ctx->trace->rings[0];
+	ctx->trace_ring->pid = getpid();
+	snprintf(ctx->trace_ring->name, TRACE_NAME_LEN, "master");
+	return 0;
+}
+
+trace_ring_t *trace_connect(int slot, const char *name) {
+	int fd = shm_open(shm_name(GAME_TRACE_SHM), O_RDWR, 0);
+	if (fd == -1)
+		return NULL;
+
+	// El mapeo se mantiene hasta que el proceso termina
+	game_trace_t *trace = mmap(NULL, sizeof(game_trace_t), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+	close(fd);
+	if (trace == MAP_FAILED)
+		return NULL;
+
+	trace_ring_t *ring = &trace->rings[slot];
+	ring->pid = getpid();
+	snprintf(ring->name, TRACE_NAME_LEN, "%s", name);
+	return ring;
+}
+
+/**
+ * @brief Primer evento valido de un anillo (los anteriores fueron pisados)
+ */
+static unsigned long long first_event(unsigned long long head) {
+	return (head > TRACE_RING_EVENTS) ? head - TRACE_RING_EVENTS : 0;
+}
+
+/**
+ * @brief Escribe los eventos de todos los anillos en formato Chrome trace
+ * @return Cantidad de eventos pisados antes de poder escribirlos
+ */
+static unsigned long long write_trace(const game_trace_t *trace, FILE *file) {
+	// Los tiempos se escriben relativos al primer evento
+	unsigned long long base = 0;
+	for (int slot = 0; slot < TRACE_SLOTS; slot++) {
+		const trace_ring_t *ring = &trace->rings[slot];
+		unsigned long long head = __atomic_load_n(&ring->head, __ATOMIC_ACQUIRE);
+		for (unsigned long long i = first_event(head); i < head; i++) {
+			unsigned long long start = ring->events[i & (TRACE_RING_EVENTS - 1)].start_ns;
+			if (base == 0 || start < base) {
+				base = start;
+			}
+		}
+	}
+
+	unsigned long long dropped = 0;
+	bool first = true;
+	fprintf(file, "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[");
+	for (int slot = 0; slot < TRACE_SLOTS; slot++) {
+		const trace_ring_t *ring = &trace->rings[slot];
+		if (ring->pid == 0)
+			continue;
+
+		// Una pista por lugar: en el modo con threads todos comparten el proceso del master
+		const char *process = (ring->pid == trace->rings[0].pid) ? trace->rings[0].name : ring->name;
+		fprintf(file, "%s\n{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":%d,\"tid\":%d,\"args\":{\"name\":\"%s\"}}",
+				first ? "" : ",", ring->pid, slot, process);
+		fprintf(file, ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":%d,\"tid\":%d,\"args\":{\"name\":\"%s\"}}",
+				ring->pid, slot, ring->name);
+		first = false;
+
+		unsigned long long head = __atomic_load_n(&ring->head, __ATOMIC_ACQUIRE);
+		dropped += first_event(head);
+		for (unsigned long long i = first_event(head); i < head; i++) {
+			const trace_event_t *event = &ring->events[i & (TRACE_RING_EVENTS - 1)];
+			if (event->phase >= TRACE_PHASES)
+				continue;
+			fprintf(file, ",\n{\"name\":\"%s\",\"cat\":\"%s\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,",
+					phase_names[event->phase], phase_category((trace_phase_t) event->phase),
+					(event->start_ns - base) / 1000.0, event->duration_ns / 1000.0);
+			fprintf(file, "\"pid\":%d,\"tid\":%d", ring->pid, slot);
+			if (event->arg != TRACE_NO_ARG) {
+				fprintf(file, ",\"args\":{\"player\":%u}", event->arg + 1);
+			}
+			fprintf(file, "}");
+		}
+	}
+	fprintf(file, "\n]}\n");
+	return dropped;
+}
+
+void trace_destroy(master_context_t *ctx) {
+	if (ctx->trace == NULL)
+		return;
+
+	FILE *file = fopen(ctx->config.trace_path, "w");
+	if (file == NULL) {
+		perror("Error opening trace file");
+	}
+	else {
+		unsigned long long dropped = write_trace(ctx->trace, file);
+		fclose(file);
+		printf("Trace written to %s", ctx->config.trace_path);
+		if (dropped > 0) {
+			printf(" (%llu oldest events overwritten)", dropped);
+		}
+		printf("\n");
+	}
+
+	// Con threads todavia vivos (terminacion por señal) la memoria se libera al salir del proceso
+	if (!ctx->config.threads) {
+		munmap(ctx->trace, sizeof(game_trace_t));
+		shm_unlink(shm_name(GAME_TRACE_SHM));
+	}
+	else if (ctx->threads == NULL) {
+		free(ctx->trace);
+	}
+	ctx->trace = NULL;
+	ctx->trace_ring = NULL;
+}
@@ -0,0 +1,105 @@
+#ifndef TRACE_H
+#define TRACE_H
+
+#include "common.h"
+
+/*
+ * Trazas de las fases de cada proceso en una sola linea de tiempo (--trace).
+ *
+ * El master crea el segmento GAME_TRACE_SHM con un anillo por proceso (0 el master, 1..9 los jugadores y
+ * TRACE_VIEW_SLOT la vista). Cada proceso es el unico productor de su anillo: escribe el evento en la posicion
+ * head y recien despues publica head + 1, sin locks ni semaforos. Si el anillo se llena se pisan los eventos mas
+ * viejos. Los tiempos son CLOCK_MONOTONIC, comun a todos los procesos. Al salir, el master une los anillos en un
+ * archivo JSON de Chrome trace (chrome://tracing o ui.perfetto.dev).
+ *
+ * Con anillo NULL (sin --trace) trace_now no lee el reloj y trace_span no hace nada.
+ */
+
+#define GAME_TRACE_SHM "/game_trace"
+#define TRACE_RING_EVENTS 16384 // Potencia de dos
+#define TRACE_VIEW_SLOT (MAX_PLAYERS + 1)
+#define TRACE_SLOTS (MAX_PLAYERS + 2)
+#define TRACE_NO_ARG 0xFFFFFFFFu
+#define TRACE_NAME_LEN (2 * MAX_NAME_LEN) // "P<n> " y el nombre del jugador
+
+typedef enum {
+	// Master
+	TRACE_SELECT = 0,
+	TRACE_READ,
+	TRACE_VALIDATE,
+	TRACE_EXECUTE,
+	TRACE_CHECK_END,
+	TRACE_VIEW_SYNC,
+	TRACE_SLEEP,
+	// Jugadores
+	TRACE_TURN_WAIT,
+	TRACE_READ_LOCK,
+	TRACE_STRATEGY,
+	TRACE_SEND_MOVE,
+	// Vista
+	TRACE_VIEW_WAIT,
+	TRACE_RENDER,
+	TRACE_FLUSH,
+	TRACE_PHASES
+} trace_phase_t;
+
+// Evento de tamaño fijo (24 bytes)
+typedef struct {
+	unsigned long long start_ns; // Inicio (CLOCK_MONOTONIC)
+	unsigned int duration_ns;	 // Duracion (acotada a ~4 s)
+	unsigned int phase;			 // trace_phase_t
+	unsigned int arg;			 // Jugador del evento (TRACE_NO_ARG si no aplica)
+	unsigned int padding;		 // Alineacion
+} trace_event_t;
+
+// Anillo de un proceso
+typedef struct trace_ring {
+	pid_t pid;								 // Proceso productor (0 si no se uso)
+	char name[TRACE_NAME_LEN];				 // Nombre de la pista
+	unsigned long long head;				 // Eventos escritos (publicado despues de escribir el evento)
+	trace_event_t events[TRACE_RING_EVENTS]; // Ultimos TRACE_RING_EVENTS eventos
+} trace_ring_t;
+
+// Segmento compartido
+typedef struct game_trace {
+	trace_ring_t rings[TRACE_SLOTS];
+} game_trace_t;
+
+/**
+ * @brief Momento actual para empezar un evento
+ * @param ring Anillo del proceso
+ * @return CLOCK_MONOTONIC en nanosegundos, 0 si ring es NULL
+ */
+unsigned long long trace_now(const trace_ring_t *ring);
+
+/**
+ * @brief Registra un evento que empezo en start y termina ahora
+ * @param ring Anillo del proceso (NULL: sin trazas)
+ * @param phase Fase
+ * @param start Valor de trace_now al empezar
+ * @param arg Jugador del evento o TRACE_NO_ARG
+ */
+void trace_span(trace_ring_t *ring, trace_phase_t phase, unsigned long long start, unsigned int arg);
+
+/**
+ * @brief Crea el segmento de trazas y toma el anillo del master
+ * @param ctx Puntero al contexto del master
+ * @return 0 si la creacion fue exitosa, -1 en caso de error
+ */
+int trace_create(master_context_t *ctx);
+
+/**
+ * @brief Conecta un proceso a su anillo si el master publica trazas
+ * @param slot Lugar del proceso (player_id + 1 o TRACE_VIEW_SLOT)
+ * @param name Nombre de la pista
+ * @return Anillo del proceso, o NULL si no hay segmento
+ */
+trace_ring_t *trace_connect(int slot, const char *name);
+
+/**
+ * @brief Escribe el archivo de --trace con los eventos de todos los anillos y libera el segmento
+ * @param ctx Puntero al contexto del master
+ */
+void trace_destroy(master_context_t *ctx);
+
+#endif // TRACE_H
@@ -1,7 +1,10 @@
 // This is a personal academic project. Dear PVS-Studio, please check it.
 // PVS-Studio Static Code Analyzer for C, C++, C#, and Java: https://pvs-studio.com
 #include "view_functions.h"
+#include "analytics.h"
 #include "library.h"
+#include "syscall_stats.h"
+#include "trace.h"
 #include <stdio.h>
 #include <stdlib.h>
 
@@ -149,10 +152,30 @@ void print_winner(view_context_t *ctx) {
 	}
 }
 
+void print_analytics(view_context_t *ctx) {
+	if (ctx->analytics == NULL)
+		return;
+
+	analytics_summary_t summary;
+	analytics_read_summary(ctx->analytics, &summary);
+
+	printf("ANALYTICS (tick %u):\n", summary.tick);
+	printf("  Free: %u cells, %u reward in %u regions (largest: %u cells)\n", summary.free_cells, summary.free_reward,
+		   summary.region_count, summary.largest_region);
+	printf("  Reachable:");
+	for (unsigned int i = 0; i < ctx->game_state->player_count; i++) {
+		printf(" %sP%d%s %u/%u", get_player_color(i), i + 1, COLOR_RESET, summary.reachable_cells[i],
+			   summary.reachable_reward[i]);
+	}
+	printf("\n\n");
+}
+
 void print_game_state(view_context_t *ctx) {
+	unsigned long long span = trace_now(ctx->trace_ring);
 	clean_screen();
 	print_header(ctx);
 	print_players_info(ctx);
+	print_analytics(ctx);
 	print_board(ctx);
 	print_legend(ctx);
 
@@ -161,7 +184,11 @@ void print_game_state(view_context_t *ctx) {
 	}
 
 	printf("\n");
+	trace_span(ctx->trace_ring, TRACE_RENDER, span, TRACE_NO_ARG);
+
+	span = trace_now(ctx->trace_ring);
 	clean_buffer();
+	trace_span(ctx->trace_ring, TRACE_FLUSH, span, TRACE_NO_ARG);
 }
 
 void initialize_view_context(view_context_t *ctx, int argc, char *argv[]) {
@@ -177,19 +204,27 @@ void initialize_view_context(view_context_t *ctx, int argc, char *argv[]) {
 		fprintf(stderr, "Error to initialize shared memory view");
 		exit(EXIT_FAILURE);
 	}
+
+	// El analisis solo existe si el master corre con --analytics
+	ctx->analytics = analytics_connect(width, height, &ctx->analytics_fd);
+	ctx->trace_ring = trace_connect(TRACE_VIEW_SLOT, "view");
+	syscall_stats_connect(SYSCALL_VIEW_SLOT);
 }
 
 void view_main_loop(view_context_t *ctx) {
 	while (1) {
 		// Esperar señal del master
-		if (sem_wait(&ctx->game_sync->view_ready) != 0) {
+		unsigned long long span = trace_now(ctx->trace_ring);
+		if (spin_wait(&ctx->game_sync->view_ready, 0, &ctx->view_ready_wait) != 0) {
 			perror("Error receiving signal from Master");
 			break;
 		}
+		trace_span(ctx->trace_ring, TRACE_VIEW_WAIT, span, TRACE_NO_ARG);
 
 		print_game_state(ctx);
 
 		// Notificar al master
+		syscall_count(SYSCALL_SEM_POST);
 		if (sem_post(&ctx->game_sync->view_done) != 0) {
 			perror("Error sending signal to Master");
 			break;
@@ -200,4 +235,8 @@ void view_main_loop(view_context_t *ctx) {
 			break;
 		}
 	}
+
+	if (wait_stats_enabled()) {
+		print_wait_stats(stderr, "View", "view_ready", &ctx->view_ready_wait);
+	}
 }
@@ -41,6 +41,12 @@ void print_winner(view_context_t *ctx);
  */
 void print_game_state(view_context_t *ctx);
 
+/**
+ * @brief Imprime el analisis publicado por el master (regiones libres y area alcanzable), si existe
+ * @param ctx Puntero al contexto del view
+ */
+void print_analytics(view_context_t *ctx);
+
 /**
  * @brief Inicializa el contexto del view
  * @param ctx Puntero al contexto del view
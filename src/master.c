@@ -1,12 +1,21 @@
 // This is a personal academic project. Dear PVS-Studio, please check it.
 // PVS-Studio Static Code Analyzer for C, C++, C#, and Java: https://pvs-studio.com
 #define _GNU_SOURCE
+#include "lib/analytics.h"
 #include "lib/common.h"
 #include "lib/config_management.h"
+#include "lib/endgame.h"
 #include "lib/game_logic.h"
+#include "lib/game_record.h"
 #include "lib/library.h"
+#include "lib/live_stats.h"
+#include "lib/lock_stats.h"
 #include "lib/memory_management.h"
+#include "lib/placement.h"
 #include "lib/process_management.h"
+#include "lib/syscall_stats.h"
+#include "lib/thread_mode.h"
+#include "lib/trace.h"
 #include <errno.h>
 #include <fcntl.h>
 #include <signal.h>
@@ -23,10 +32,12 @@ master_context_t master_ctx = {0};
 
 /**
  * @brief Wrapper para cleanup del master
- * @details Necesario para usar con atexit
+ * @details Necesario para usar con atexit. Con CHOMP_ENDGAME_TT=drop tambien desvincula la tabla de finales: los
+ * jugadores ya fueron recogidos
  */
 void master_cleanup_wrapper(void) {
 	master_cleanup(&master_ctx);
+	endgame_unlink_shared();
 }
 /**
  * @brief Manejador de señales especifico para master
@@ -38,25 +49,21 @@ void master_signal_handler(int sig) {
 	generic_signal_handler(sig, "Master", -1, master_cleanup_wrapper);
 }
 
-int main(int argc, char *argv[]) {
-	atexit(master_cleanup_wrapper);
-
-	setup_standard_signals(master_signal_handler);
-	signal(SIGCHLD, SIG_IGN); // Evita procesos zombie
-
-	parse_arguments(argc, argv, &master_ctx.config);
-
-	if (create_shared_memories(&master_ctx) != 0) {
-		fprintf(stderr, "Failed to create shared memories\n");
-		exit(EXIT_FAILURE);
+/**
+ * @brief Movimientos procesados por el master (validos e invalidos de todos los jugadores)
+ */
+static unsigned long long processed_moves(void) {
+	unsigned long long moves = 0;
+	for (int i = 0; i < master_ctx.config.player_count; i++) {
+		moves += master_ctx.game_state->players[i].valid_moves + master_ctx.game_state->players[i].invalid_moves;
 	}
+	return moves;
+}
 
-	initialize_game_state(&master_ctx);
-
-	initialize_synchronization(&master_ctx);
-
-	display_game_parameters(&master_ctx.config);
-
+/**
+ * @brief Ejecuta la partida con jugadores y vista como procesos comunicados por memoria compartida y pipes
+ */
+static void run_process_game(void) {
 	if (create_processes(&master_ctx) != 0) {
 		fprintf(stderr, "Failed to create processes\n");
 		master_cleanup(&master_ctx);
@@ -64,9 +71,19 @@ int main(int argc, char *argv[]) {
 	}
 
 	display_processes_info(&master_ctx.config, master_ctx.player_pids, master_ctx.view_pid, master_ctx.view_active);
+	if (master_ctx.config.pin != NULL || master_ctx.config.sched != NULL) {
+		placement_report(&master_ctx);
+	}
 
 	display_game_start();
 
+	// Barrera de arranque: los jugadores avisan cuando cargaron su estrategia. Con vista se mantiene la pausa para
+	// que el usuario pueda leer la informacion.
+	wait_players_ready(&master_ctx, START_SLEEP_SEC);
+	if (master_ctx.view_active) {
+		sleep(START_SLEEP_SEC);
+	}
+
 	// Notificar a view que la memoria compartida esta lista
 	if (master_ctx.view_active && master_ctx.config.view_path != NULL) {
 		sem_post(&master_ctx.game_sync->view_ready);
@@ -74,7 +91,7 @@ int main(int argc, char *argv[]) {
 
 	// Notificar a todos los jugadores que pueden empezar a jugar
 	for (int i = 0; i < master_ctx.config.player_count; i++) {
-		sem_post(&master_ctx.game_sync->player_turn[i]);
+		grant_turn(&master_ctx, i);
 	}
 
 	// Ejecutar bucle principal del juego
@@ -82,26 +99,148 @@ int main(int argc, char *argv[]) {
 
 	// Verificar el codigo de salida de la view
 	if (master_ctx.view_active && master_ctx.view_pid > 0) {
-		sem_wait(&master_ctx.game_sync->view_done);
-
-		int view_status;
-		pid_t result = waitpid(master_ctx.view_pid, &view_status, 0);
-		if (result > 0) {
-			int exit_code = 0;
-			if (WIFEXITED(view_status)) {
-				exit_code = WEXITSTATUS(view_status);
-			}
-			else if (WIFSIGNALED(view_status)) {
-				exit_code = WTERMSIG(view_status);
-			}
-			printf("View exited (%d)\n", exit_code);
-		}
-		else {
-			printf("View exited (0)\n");
+		spin_wait(&master_ctx.game_sync->view_done, VIEW_TIMEOUT_SEC, &master_ctx.view_done_wait);
+	}
+
+	// Si el bucle termino por timeout los jugadores todavia esperan su turno: se les avisa para que salgan solos
+	if (!master_ctx.game_state->game_finished) {
+		finish_game(&master_ctx);
+	}
+
+	// Se les da un plazo para salir y despues SIGTERM/SIGKILL a los rezagados
+	reap_children(&master_ctx, REAP_GRACE_MS, REAP_TERM_MS);
+	if (master_ctx.view_reaped) {
+		printf("View exited (%d)\n", child_exit_code(master_ctx.view_status));
+	}
+}
+
+/**
+ * @brief Ejecuta la partida con los jugadores como threads del master (--threads)
+ * @details Sin vista, sin pipes y sin semaforos entre procesos: cota inferior del costo de IPC
+ */
+static void run_threaded_game(void) {
+	clock_gettime(CLOCK_MONOTONIC, &master_ctx.start_time);
+	if (create_player_threads(&master_ctx) != 0) {
+		fprintf(stderr, "Failed to create player threads\n");
+		exit(EXIT_FAILURE);
+	}
+
+	display_processes_info(&master_ctx.config, NULL, -1, false);
+	if (master_ctx.config.pin != NULL || master_ctx.config.sched != NULL) {
+		placement_report(&master_ctx);
+	}
+
+	wait_players_ready(&master_ctx, START_SLEEP_SEC);
+
+	// Notificar a todos los jugadores que pueden empezar a jugar
+	for (int i = 0; i < master_ctx.config.player_count; i++) {
+		grant_turn(&master_ctx, i);
+	}
+
+	thread_game_loop(&master_ctx);
+
+	join_player_threads(&master_ctx);
+}
+
+int main(int argc, char *argv[]) {
+	atexit(master_cleanup_wrapper);
+
+	setup_standard_signals(master_signal_handler);
+	// SIGCHLD queda con la accion por defecto: los hijos se recogen con reap_children para conocer su estado
+
+	parse_arguments(argc, argv, &master_ctx.config);
+
+	// Los jugadores con presupuesto de tiempo (player_mcts) lo derivan del timeout
+	char timeout_str[16];
+	snprintf(timeout_str, sizeof(timeout_str), "%d", master_ctx.config.timeout);
+	setenv(TIMEOUT_ENV, timeout_str, 1);
+
+	// El master se ubica antes de crear los hijos (los threads de --threads heredan su afinidad)
+	placement_apply(&master_ctx, 0, PLACEMENT_MASTER);
+
+	// Sin --spin cada proceso decide segun la cantidad de CPUs
+	if (master_ctx.config.spin_us >= 0) {
+		char spin_str[16];
+		snprintf(spin_str, sizeof(spin_str), "%d", master_ctx.config.spin_us);
+		setenv(SPIN_ENV, spin_str, 1);
+	}
+
+	if (master_ctx.config.threads) {
+		if (create_private_memories(&master_ctx) != 0) {
+			fprintf(stderr, "Failed to allocate game memory\n");
+			exit(EXIT_FAILURE);
 		}
 	}
+	else if (create_shared_memories(&master_ctx) != 0) {
+		fprintf(stderr, "Failed to create shared memories\n");
+		exit(EXIT_FAILURE);
+	}
+
+	initialize_game_state(&master_ctx);
+
+	if (master_ctx.config.analytics && analytics_create(&master_ctx) != 0) {
+		fprintf(stderr, "Failed to create analytics shared memory\n");
+		exit(EXIT_FAILURE);
+	}
+
+	if (master_ctx.config.live_stats && live_stats_create(&master_ctx) != 0) {
+		fprintf(stderr, "Failed to create live stats shared memory\n");
+		exit(EXIT_FAILURE);
+	}
+
+	// Los jugadores se conectan a los segmentos al inicializarse, asi que tienen que existir antes de crearlos
+	if (master_ctx.config.lock_stats && lock_stats_create(&master_ctx.lock_stats, !master_ctx.config.threads) != 0) {
+		fprintf(stderr, "Failed to create lock stats\n");
+		exit(EXIT_FAILURE);
+	}
+
+	if (master_ctx.config.trace_path != NULL && trace_create(&master_ctx) != 0) {
+		fprintf(stderr, "Failed to create trace rings\n");
+		exit(EXIT_FAILURE);
+	}
+
+	if (master_ctx.config.syscalls && syscall_stats_create(&master_ctx.syscalls, !master_ctx.config.threads) != 0) {
+		fprintf(stderr, "Failed to create syscall counters\n");
+		exit(EXIT_FAILURE);
+	}
+
+	if (master_ctx.config.record_path != NULL && record_open(&master_ctx) != 0) {
+		fprintf(stderr, "Failed to open record file\n");
+		exit(EXIT_FAILURE);
+	}
+
+	initialize_synchronization(&master_ctx);
+
+	display_game_parameters(&master_ctx.config);
+
+	if (master_ctx.config.threads) {
+		run_threaded_game();
+	}
+	else {
+		run_process_game();
+	}
+
+	record_close(&master_ctx);
 
 	print_final_results(&master_ctx);
+	print_resource_usage(&master_ctx);
+	if (master_ctx.config.pin != NULL || master_ctx.config.sched != NULL) {
+		placement_summary(&master_ctx);
+	}
+	if (master_ctx.config.latency) {
+		print_latency(&master_ctx);
+	}
+	print_startup_times(&master_ctx);
+	if (master_ctx.lock_stats != NULL) {
+		lock_stats_print(master_ctx.lock_stats, master_ctx.config.player_count);
+	}
+	if (master_ctx.syscalls != NULL) {
+		syscall_stats_print(master_ctx.syscalls, master_ctx.config.player_count, processed_moves());
+	}
+
+	if (wait_stats_enabled() && master_ctx.config.view_path != NULL) {
+		print_wait_stats(stdout, "Master", "view_done", &master_ctx.view_done_wait);
+	}
 
 	master_cleanup(&master_ctx);
 
@@ -1,6 +1,7 @@
 // This is a personal academic project. Dear PVS-Studio, please check it.
 // PVS-Studio Static Code Analyzer for C, C++, C#, and Java: https://pvs-studio.com
 #define _GNU_SOURCE
+#include "lib/analytics.h"
 #include "lib/common.h"
 #include "lib/library.h"
 #include "lib/player_functions.h"
@@ -10,15 +11,16 @@
 #include <stdlib.h>
 #include <time.h>
 
-#define tornado_strategic true
+#define DEFAULT_STRATEGY "tornado"
 
-player_context_t player_ctx = {0};
+player_context_t player_ctx = {.analytics_fd = -1};
 
 /**
  * @brief Wrapper para cleanup del player
  * @details Necesario para usar con atexit
  */
 void player_cleanup_wrapper(void) {
+	analytics_disconnect(&player_ctx.analytics, &player_ctx.analytics_fd);
 	close_up(&player_ctx.sync_fd, &player_ctx.state_fd, &player_ctx.game_state, &player_ctx.game_sync);
 }
 
@@ -39,7 +41,8 @@ int main(int argc, char *argv[]) {
 
 	initialize_player_context(&player_ctx, argc, argv);
 
-	player_main_loop(&player_ctx, tornado_strategic);
+	// La estrategia puede indicarse como tercer parametro (-p ./bin/player:estrategia en el master)
+	player_main_loop(&player_ctx, argc > 3 ? argv[3] : DEFAULT_STRATEGY);
 
 	return EXIT_SUCCESS;
 }
\ No newline at end of file
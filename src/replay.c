@@ -0,0 +1,137 @@
+// This is a personal academic project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: https://pvs-studio.com
+#define _GNU_SOURCE
+#include "lib/common.h"
+#include "lib/game_logic.h"
+#include "lib/game_record.h"
+#include "lib/library.h"
+#include "lib/memory_management.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/**
+ * @brief Re-simula una partida grabada aplicando las mismas reglas que el master
+ * @param path Ruta del archivo (para los mensajes)
+ * @param record Partida cargada en memoria
+ * @param quiet Si es true solo se informan las partidas que no coinciden
+ * @return true si el resultado re-simulado coincide con el grabado
+ */
+static bool verify_record(const char *path, const game_record_t *record, bool quiet) {
+	master_context_t ctx;
+	memset(&ctx, 0, sizeof(ctx));
+
+	char *names[MAX_PLAYERS];
+	for (unsigned int i = 0; i < record->header.player_count; i++) {
+		names[i] = (char *) record->header.names[i];
+	}
+
+	ctx.config.width = record->header.width;
+	ctx.config.height = record->header.height;
+	ctx.config.seed = record->header.seed;
+	ctx.config.player_count = (int) record->header.player_count;
+	ctx.config.player_paths = names;
+
+	// El estado vive en memoria privada: no hay memoria compartida ni procesos
+	ctx.game_state = malloc(calculate_game_state_size(ctx.config.width, ctx.config.height));
+	if (ctx.game_state == NULL) {
+		perror("Error allocating memory for game state");
+		return false;
+	}
+
+	initialize_game_state(&ctx);
+
+	bool ok = true;
+	for (unsigned int i = 0; i < record->move_count; i++) {
+		const record_move_t *move = &record->moves[i];
+		if (move->player_id >= record->header.player_count) {
+			printf("FAIL %s: move %u has invalid player %u\n", path, i, move->player_id);
+			ok = false;
+			break;
+		}
+
+		if (is_valid_move(move->player_id, move->direction, ctx.game_state)) {
+			execute_player_move(&ctx, move->player_id, move->direction);
+		}
+		else {
+			ctx.game_state->players[move->player_id].invalid_moves++;
+		}
+	}
+
+	if (ok && record->move_count != record->footer.move_count) {
+		printf("FAIL %s: %u moves recorded, footer says %u\n", path, record->move_count, record->footer.move_count);
+		ok = false;
+	}
+
+	for (unsigned int i = 0; ok && i < record->header.player_count; i++) {
+		const player_t *player = &ctx.game_state->players[i];
+		if (player->score != record->footer.scores[i] || player->valid_moves != record->footer.valid_moves[i] ||
+			player->invalid_moves != record->footer.invalid_moves[i]) {
+			printf("FAIL %s: P%u replayed %u points (%u V, %u I), recorded %u points (%u V, %u I)\n", path, i + 1,
+				   player->score, player->valid_moves, player->invalid_moves, record->footer.scores[i],
+				   record->footer.valid_moves[i], record->footer.invalid_moves[i]);
+			ok = false;
+		}
+	}
+
+	if (ok && !quiet) {
+		printf("OK   %s: %u moves, seed %u, %ux%u, %u players\n", path, record->move_count, record->header.seed,
+			   record->header.width, record->header.height, record->header.player_count);
+	}
+
+	free(ctx.game_state);
+	return ok;
+}
+
+int main(int argc, char *argv[]) {
+	bool quiet = false;
+	int first_file = 1;
+
+	if (argc > 1 && strcmp(argv[1], "-q") == 0) {
+		quiet = true;
+		first_file = 2;
+	}
+
+	if (first_file >= argc) {
+		fprintf(stderr, "Usage: %s [-q] record_file [record_file ...]\n", argv[0]);
+		return EXIT_FAILURE;
+	}
+
+	int games = 0;
+	int failures = 0;
+	unsigned long long total_moves = 0;
+	double simulation_sec = 0.0;
+
+	for (int i = first_file; i < argc; i++) {
+		game_record_t record;
+		games++;
+
+		if (record_load(argv[i], &record) != 0) {
+			printf("FAIL %s: could not load record\n", argv[i]);
+			failures++;
+			continue;
+		}
+
+		// Solo se mide la re-simulacion, no la lectura del archivo
+		struct timespec start, end;
+		clock_gettime(CLOCK_MONOTONIC, &start);
+		bool ok = verify_record(argv[i], &record, quiet);
+		clock_gettime(CLOCK_MONOTONIC, &end);
+
+		simulation_sec += (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) / 1e9;
+		total_moves += record.move_count;
+		if (!ok)
+			failures++;
+
+		record_free(&record);
+	}
+
+	printf("Verified %d/%d games, %llu moves in %.3f s", games - failures, games, total_moves, simulation_sec);
+	if (simulation_sec > 0.0) {
+		printf(" (%.0f moves/s)", total_moves / simulation_sec);
+	}
+	printf("\n");
+
+	return failures == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
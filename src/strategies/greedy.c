@@ -0,0 +1,36 @@
+// This is a personal academic project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: https://pvs-studio.com
+#include "../lib/common.h"
+#include "../lib/engine.h"
+#include "../lib/strategy.h"
+
+/*
+ * Estrategia greedy (plugin): se mueve a la celda vecina libre con mayor recompensa.
+ * Se compila como objeto compartido y se usa con -p ./bin/player:greedy
+ */
+
+static direction_t greedy_choose_move(void *data, int player_id, const game_state_t *state) {
+	(void) data;
+	const player_t *player = &state->players[player_id];
+
+	direction_t best_move = DIR_UP;
+	int best_reward = 0;
+
+	for (int dir = 0; dir < ENGINE_DIRECTIONS; dir++) {
+		int x, y;
+		if (engine_target(state->board, state->width, state->height, player->x, player->y, (direction_t) dir, &x,
+						  &y)) {
+			int reward = state->board[y * state->width + x];
+			if (reward > best_reward) {
+				best_reward = reward;
+				best_move = (direction_t) dir;
+			}
+		}
+	}
+
+	return best_move;
+}
+
+// Solo mira las 8 celdas vecinas: se puede precalcular mientras espera el turno
+const strategy_t chomp_strategy = {STRATEGY_ABI_VERSION, "greedy", NULL, greedy_choose_move, NULL, NULL,
+								   1, NULL};
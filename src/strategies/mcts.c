@@ -0,0 +1,12 @@
+// This is a personal academic project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: https://pvs-studio.com
+#include "../lib/common.h"
+#include "../lib/mcts.h"
+#include "../lib/strategy.h"
+
+/*
+ * La estrategia MCTS como plugin, para usarla desde cualquier binario con -p ./bin/player:mcts
+ */
+
+const strategy_t chomp_strategy = {STRATEGY_ABI_VERSION, MCTS_NAME, mcts_init, mcts_choose_move, mcts_on_state,
+								   mcts_destroy, 0, NULL};
@@ -0,0 +1,613 @@
+// This is a personal academic project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: https://pvs-studio.com
+#define _GNU_SOURCE
+#include "lib/common.h"
+#include "lib/live_stats.h"
+#include "lib/lock_stats.h"
+#include "lib/syscall_stats.h"
+#include "lib/trace.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <spawn.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <time.h>
+#include <unistd.h>
+
+/*
+ * Torneos: corre una matriz de partidas (binarios de jugadores x tamaños de tablero x cantidades de jugadores x
+ * semillas) con hasta -j masters a la vez, sin vista y sin retardo.
+ *
+ * Cada partida en curso ocupa un lugar y corre con CHOMP_SHM_NAMESPACE=t<pid>_<lugar>, asi sus segmentos no chocan
+ * con los de las otras partidas (los hijos del master heredan la variable). La salida del master va a un memfd que
+ * se interpreta al terminar: resultados finales y tiempos de arranque. Los asientos se rotan entre los binarios
+ * para que cada uno juegue desde cada posicion.
+ *
+ * Se escribe una fila CSV por partida y al final un CSV por binario con partidas, victorias y puntajes.
+ */
+
+#define DEFAULT_MASTER "./bin/master"
+#define DEFAULT_GAME_TIMEOUT_SEC DEFAULT_TIMEOUT_SEC
+#define MAX_BINARIES 32
+#define MAX_LIST 256	   // Cantidades y tamaños de tablero
+#define MAX_SEEDS 1000000 // Acota la matriz ante un rango de semillas mal escrito
+#define OUTPUT_LIMIT (64 * 1024) // Salida del master que se interpreta
+
+// Partida de la matriz
+typedef struct {
+	int width;
+	int height;
+	int players;
+	int rotation; // Desplazamiento de los asientos sobre la lista de binarios
+	unsigned int seed;
+} game_spec_t;
+
+// Partida en curso
+typedef struct {
+	pid_t pid;					 // Master (0 si el lugar esta libre)
+	int game;					 // Indice en la matriz
+	int output_fd;				 // memfd con la salida del master
+	unsigned long long start_ns; // Momento del spawn
+} running_game_t;
+
+// Resultado de una partida
+typedef struct {
+	bool ok;						   // El master termino bien y se encontraron los resultados
+	unsigned int score[MAX_PLAYERS];   // Por asiento
+	unsigned int valid[MAX_PLAYERS];   // Por asiento
+	unsigned int invalid[MAX_PLAYERS]; // Por asiento
+	int winner;						   // Asiento ganador (-1: empate o error)
+	double wall_ms;					   // Desde el spawn hasta que se recogio el master
+	double ready_ms;				   // Barrera de arranque
+	double first_move_ms;			   // Primer movimiento
+	double last_move_ms;			   // Ultimo movimiento
+} game_result_t;
+
+// Totales de un binario
+typedef struct {
+	unsigned long long seats;	// Asientos ocupados (un binario puede repetirse en una partida)
+	unsigned long long wins;	// Asientos que ganaron
+	unsigned long long score;	// Puntaje total
+	unsigned long long valid;	// Movimientos validos
+	unsigned long long invalid; // Movimientos invalidos
+} binary_stats_t;
+
+typedef struct {
+	const char *master;
+	char *binaries[MAX_BINARIES];
+	int binary_count;
+	int counts[MAX_LIST];
+	int count_count;
+	int sizes[MAX_LIST][2];
+	int size_count;
+	unsigned int *seeds; // Reservadas al interpretar -s
+	int seed_count;
+	int jobs;
+	int timeout;
+	const char *games_path;
+	const char *ranking_path;
+} tournament_config_t;
+
+static unsigned long long now_ns(void) {
+	struct timespec now;
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return (unsigned long long) now.tv_sec * 1000000000ULL + (unsigned long long) now.tv_nsec;
+}
+
+static void usage(const char *program) {
+	fprintf(stderr,
+			"Usage: %s -p player... [-c counts] [-b sizes] [-s seeds] [-j jobs] [-t timeout] [-m master] "
+			"[-o games.csv] [-r ranking.csv]\n",
+			program);
+	fprintf(stderr, "  -c  Player counts, e.g. 2,4 (default: number of binaries)\n");
+	fprintf(stderr, "  -b  Board sizes, e.g. 10x10,20x20 (default: %dx%d)\n", DEFAULT_BOARD_WIDTH,
+			DEFAULT_BOARD_HEIGHT);
+	fprintf(stderr, "  -s  Seeds, e.g. 1-100 or 3,7,11 (default: 1)\n");
+	fprintf(stderr, "  -j  Concurrent masters (default: online CPUs)\n");
+	fprintf(stderr, "  -o  Per-game CSV (default: stdout); -r per-binary CSV (default: stderr)\n");
+}
+
+/**
+ * @brief Interpreta una lista separada por comas; cada elemento puede ser un rango a-b
+ * @param values Arreglo reservado con los elementos (lo libera quien llama)
+ * @param limit Cantidad maxima de elementos
+ * @return Cantidad de elementos, o -1 si la lista es invalida, tiene mas de limit o no se pudo reservar
+ */
+static int parse_int_list(const char *text, unsigned int **values, int limit) {
+	int count = 0, capacity = 0;
+	*values = NULL;
+	const char *p = text;
+	while (*p != '\0') {
+		char *end;
+		unsigned long first = strtoul(p, &end, 10);
+		unsigned long last = first;
+		if (end == p)
+			return -1;
+		if (*end == '-') {
+			p = end + 1;
+			last = strtoul(p, &end, 10);
+			if (end == p || last < first)
+				return -1;
+		}
+		if (last - first >= (unsigned long) (limit - count))
+			return -1;
+
+		int needed = count + (int) (last - first) + 1;
+		if (needed > capacity) {
+			capacity = (needed > 2 * capacity) ? needed : 2 * capacity;
+			unsigned int *grown = realloc(*values, (size_t) capacity * sizeof(unsigned int));
+			if (grown == NULL)
+				return -1;
+			*values = grown;
+		}
+		for (unsigned long v = first; v <= last; v++) {
+			(*values)[count++] = (unsigned int) v;
+		}
+		if (*end == ',') {
+			end++;
+		}
+		else if (*end != '\0') {
+			return -1;
+		}
+		p = end;
+	}
+	return count;
+}
+
+static int parse_sizes(const char *text, int sizes[][2]) {
+	int count = 0;
+	const char *p = text;
+	while (*p != '\0') {
+		int width, height, consumed;
+		if (count == MAX_LIST || sscanf(p, "%dx%d%n", &width, &height, &consumed) != 2 || width < 10 || height < 10)
+			return -1;
+		sizes[count][0] = width;
+		sizes[count][1] = height;
+		count++;
+		p += consumed;
+		if (*p == ',') {
+			p++;
+		}
+		else if (*p != '\0') {
+			return -1;
+		}
+	}
+	return count;
+}
+
+static int parse_args(int argc, char *argv[], tournament_config_t *config) {
+	memset(config, 0, sizeof(*config));
+	config->master = DEFAULT_MASTER;
+	config->timeout = DEFAULT_GAME_TIMEOUT_SEC;
+	long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+	config->jobs = (cpus > 0) ? (int) cpus : 1;
+	config->sizes[0][0] = DEFAULT_BOARD_WIDTH;
+	config->sizes[0][1] = DEFAULT_BOARD_HEIGHT;
+	config->size_count = 1;
+	config->seed_count = 0;
+
+	for (int i = 1; i < argc; i++) {
+		const char *value = (i + 1 < argc) ? argv[i + 1] : NULL;
+		if (strcmp(argv[i], "-p") == 0) {
+			// Como en el master: todo lo que sigue hasta la proxima opcion son binarios
+			while (i + 1 < argc && argv[i + 1][0] != '-') {
+				if (config->binary_count == MAX_BINARIES)
+					return -1;
+				config->binaries[config->binary_count++] = argv[++i];
+			}
+			continue;
+		}
+		if (value == NULL)
+			return -1;
+		i++;
+		if (strcmp(argv[i - 1], "-c") == 0) {
+			unsigned int *counts;
+			config->count_count = parse_int_list(value, &counts, MAX_LIST);
+			for (int c = 0; c < config->count_count; c++) {
+				if (counts[c] < 1 || counts[c] > MAX_PLAYERS) {
+					config->count_count = -1;
+					break;
+				}
+				config->counts[c] = (int) counts[c];
+			}
+			free(counts);
+			if (config->count_count <= 0)
+				return -1;
+		}
+		else if (strcmp(argv[i - 1], "-b") == 0) {
+			if ((config->size_count = parse_sizes(value, config->sizes)) <= 0)
+				return -1;
+		}
+		else if (strcmp(argv[i - 1], "-s") == 0) {
+			free(config->seeds);
+			if ((config->seed_count = parse_int_list(value, &config->seeds, MAX_SEEDS)) <= 0)
+				return -1;
+		}
+		else if (strcmp(argv[i - 1], "-j") == 0) {
+			if ((config->jobs = atoi(value)) <= 0)
+				return -1;
+		}
+		else if (strcmp(argv[i - 1], "-t") == 0) {
+			if ((config->timeout = atoi(value)) <= 0)
+				return -1;
+		}
+		else if (strcmp(argv[i - 1], "-m") == 0) {
+			config->master = value;
+		}
+		else if (strcmp(argv[i - 1], "-o") == 0) {
+			config->games_path = value;
+		}
+		else if (strcmp(argv[i - 1], "-r") == 0) {
+			config->ranking_path = value;
+		}
+		else {
+			return -1;
+		}
+	}
+
+	if (config->binary_count == 0)
+		return -1;
+	if (config->count_count == 0) {
+		config->counts[0] = (config->binary_count < MAX_PLAYERS) ? config->binary_count : MAX_PLAYERS;
+		config->count_count = 1;
+	}
+	if (config->seed_count == 0) {
+		if ((config->seeds = malloc(sizeof(unsigned int))) == NULL)
+			return -1;
+		config->seeds[0] = 1;
+		config->seed_count = 1;
+	}
+	return 0;
+}
+
+/**
+ * @brief Arma la matriz: tamaños x cantidades x rotaciones de asientos x semillas
+ * @return Cantidad de partidas, o -1 si son demasiadas o no se pudo reservar la memoria
+ */
+static int build_matrix(const tournament_config_t *config, game_spec_t **games) {
+	size_t total = (size_t) config->size_count * config->count_count * config->binary_count * config->seed_count;
+	*games = (total <= INT_MAX) ? malloc(total * sizeof(game_spec_t)) : NULL;
+	if (*games == NULL)
+		return -1;
+
+	int n = 0;
+	for (int s = 0; s < config->size_count; s++) {
+		for (int c = 0; c < config->count_count; c++) {
+			for (int r = 0; r < config->binary_count; r++) {
+				for (int seed = 0; seed < config->seed_count; seed++) {
+					game_spec_t *game = &(*games)[n++];
+					game->width = config->sizes[s][0];
+					game->height = config->sizes[s][1];
+					game->players = config->counts[c];
+					game->rotation = r;
+					game->seed = config->seeds[seed];
+				}
+			}
+		}
+	}
+	return n;
+}
+
+static const char *seat_binary(const tournament_config_t *config, const game_spec_t *game, int seat) {
+	return config->binaries[(game->rotation + seat) % config->binary_count];
+}
+
+static void namespace_of(int slot, char *buffer, size_t size) {
+	snprintf(buffer, size, "t%d_%d", (int) getpid(), slot);
+}
+
+/**
+ * @brief Borra los segmentos que un master pudo dejar en el espacio de nombres de un lugar (si murio sin limpiar)
+ */
+static void unlink_namespace(int slot) {
+	static const char *bases[] = {GAME_STATE_SHM,	 GAME_SYNC_SHM,	 GAME_ANALYTICS_SHM, LOCK_STATS_SHM,
+								  GAME_LIVE_STATS_SHM, GAME_TRACE_SHM, GAME_SYSCALLS_SHM};
+	char namespace[32], name[64];
+	namespace_of(slot, namespace, sizeof(namespace));
+	for (size_t i = 0; i < sizeof(bases) / sizeof(bases[0]); i++) {
+		snprintf(name, sizeof(name), "%s_%s", bases[i], namespace);
+		shm_unlink(name);
+	}
+}
+
+/**
+ * @brief Lanza el master de una partida en un lugar libre
+ * @return 0 si se pudo lanzar, -1 en caso de error
+ */
+static int spawn_game(const tournament_config_t *config, const game_spec_t *game, int index, int slot,
+					  running_game_t *running) {
+	char namespace[32], env_entry[64], width[16], height[16], timeout[16], seed[16];
+	namespace_of(slot, namespace, sizeof(namespace));
+	snprintf(env_entry, sizeof(env_entry), "%s=%s", SHM_NAMESPACE_ENV, namespace);
+	snprintf(width, sizeof(width), "%d", game->width);
+	snprintf(height, sizeof(height), "%d", game->height);
+	snprintf(timeout, sizeof(timeout), "%d", config->timeout);
+	snprintf(seed, sizeof(seed), "%u", game->seed);
+
+	char *argv[16 + MAX_PLAYERS];
+	int argc = 0;
+	argv[argc++] = (char *) config->master;
+	argv[argc++] = "-w";
+	argv[argc++] = width;
+	argv[argc++] = "-h";
+	argv[argc++] = height;
+	argv[argc++] = "-d";
+	argv[argc++] = "0";
+	argv[argc++] = "-t";
+	argv[argc++] = timeout;
+	argv[argc++] = "-s";
+	argv[argc++] = seed;
+	argv[argc++] = "-p";
+	for (int seat = 0; seat < game->players; seat++) {
+		argv[argc++] = (char *) seat_binary(config, game, seat);
+	}
+	argv[argc] = NULL;
+
+	// Entorno del driver con el espacio de nombres del lugar
+	extern char **environ;
+	int env_count = 0;
+	while (environ[env_count] != NULL) {
+		env_count++;
+	}
+	char **envp = malloc((env_count + 2) * sizeof(char *));
+	if (envp == NULL)
+		return -1;
+	int e = 0;
+	for (int i = 0; i < env_count; i++) {
+		if (strncmp(environ[i], SHM_NAMESPACE_ENV "=", strlen(SHM_NAMESPACE_ENV) + 1) != 0) {
+			envp[e++] = environ[i];
+		}
+	}
+	envp[e++] = env_entry;
+	envp[e] = NULL;
+
+	int output_fd = memfd_create("tournament_game", 0);
+	if (output_fd == -1) {
+		free(envp);
+		return -1;
+	}
+
+	posix_spawn_file_actions_t actions;
+	posix_spawn_file_actions_init(&actions);
+	posix_spawn_file_actions_adddup2(&actions, output_fd, STDOUT_FILENO);
+	posix_spawn_file_actions_addopen(&actions, STDERR_FILENO, "/dev/null", O_WRONLY, 0);
+
+	unlink_namespace(slot);
+	running->start_ns = now_ns();
+	int error = posix_spawn(&running->pid, config->master, &actions, NULL, argv, envp);
+	posix_spawn_file_actions_destroy(&actions);
+	free(envp);
+	if (error != 0) {
+		fprintf(stderr, "Error spawning %s: %s\n", config->master, strerror(error));
+		close(output_fd);
+		running->pid = 0;
+		return -1;
+	}
+	running->game = index;
+	running->output_fd = output_fd;
+	return 0;
+}
+
+/**
+ * @brief Interpreta la salida del master: resultados finales (por asiento) y linea de arranque
+ */
+static void parse_output(int fd, const game_spec_t *game, game_result_t *result) {
+	char *output = malloc(OUTPUT_LIMIT + 1);
+	if (output == NULL)
+		return;
+	ssize_t length = pread(fd, output, OUTPUT_LIMIT, 0);
+	output[length > 0 ? length : 0] = '\0';
+
+	int found = 0;
+	const char *results = strstr(output, "=== FINAL RESULTS ===");
+	for (const char *line = results; line != NULL && found < game->players;) {
+		line = strchr(line, '\n');
+		if (line == NULL)
+			break;
+		line++;
+		int rank, seat, status;
+		unsigned int score, valid, invalid;
+		// "1. player (<color>P1<reset>) (0): 314 points (69 V, 0 I)"
+		if (sscanf(line, "%d. %*s (%*[^P]P%d%*[^)]) (%d): %u points (%u V, %u I)", &rank, &seat, &status, &score,
+				   &valid, &invalid) != 6 ||
+			seat < 1 || seat > game->players)
+			break;
+		result->score[seat - 1] = score;
+		result->valid[seat - 1] = valid;
+		result->invalid[seat - 1] = invalid;
+		found++;
+	}
+
+	const char *startup = strstr(output, "Startup: players ready after ");
+	if (startup != NULL) {
+		sscanf(startup, "Startup: players ready after %lf ms, first move after %lf ms, last move after %lf ms",
+			   &result->ready_ms, &result->first_move_ms, &result->last_move_ms);
+	}
+	result->ok = (found == game->players);
+	free(output);
+}
+
+/**
+ * @brief Ganador con el criterio de la vista: mayor puntaje, luego menos movimientos validos, luego menos invalidos
+ * @return Asiento ganador, o -1 si nadie sumo puntos o hay empate en los tres criterios
+ */
+static int find_winner(const game_result_t *result, int players) {
+	int winner = -1;
+	bool tied = false;
+	for (int i = 0; i < players; i++) {
+		if (result->score[i] == 0)
+			continue;
+		if (winner == -1 || result->score[i] > result->score[winner] ||
+			(result->score[i] == result->score[winner] &&
+			 (result->valid[i] < result->valid[winner] ||
+			  (result->valid[i] == result->valid[winner] && result->invalid[i] < result->invalid[winner])))) {
+			winner = i;
+			tied = false;
+		}
+		else if (result->score[i] == result->score[winner] && result->valid[i] == result->valid[winner] &&
+				 result->invalid[i] == result->invalid[winner]) {
+			tied = true;
+		}
+	}
+	return tied ? -1 : winner;
+}
+
+static void print_game_row(FILE *out, const tournament_config_t *config, const game_spec_t *game, int index,
+						   const game_result_t *result) {
+	unsigned long long moves = 0;
+	fprintf(out, "%d,%d,%d,%d,%u,", index, game->width, game->height, game->players, game->seed);
+	for (int seat = 0; seat < game->players; seat++) {
+		fprintf(out, "%s%s", seat > 0 ? ";" : "", seat_binary(config, game, seat));
+		moves += result->valid[seat] + result->invalid[seat];
+	}
+	fprintf(out, ",");
+	for (int seat = 0; seat < game->players; seat++) {
+		fprintf(out, "%s%u", seat > 0 ? ";" : "", result->score[seat]);
+	}
+	fprintf(out, ",%d,%s,%s,%.3f,%.3f,%.3f,%llu\n", result->winner >= 0 ? result->winner + 1 : 0,
+			result->winner >= 0 ? seat_binary(config, game, result->winner) : "", result->ok ? "ok" : "failed",
+			result->wall_ms, result->ready_ms, result->last_move_ms - result->first_move_ms, moves);
+	fflush(out);
+}
+
+static void add_result(const tournament_config_t *config, const game_spec_t *game, const game_result_t *result,
+					   binary_stats_t *stats) {
+	if (!result->ok)
+		return;
+	for (int seat = 0; seat < game->players; seat++) {
+		binary_stats_t *binary = &stats[(game->rotation + seat) % config->binary_count];
+		binary->seats++;
+		binary->wins += (seat == result->winner);
+		binary->score += result->score[seat];
+		binary->valid += result->valid[seat];
+		binary->invalid += result->invalid[seat];
+	}
+}
+
+/**
+ * @brief Espera a que termine algun master, interpreta su salida y libera el lugar
+ */
+static void reap_game(const tournament_config_t *config, const game_spec_t *games, running_game_t *running,
+					 FILE *out, binary_stats_t *stats, int *failures) {
+	int status;
+	pid_t pid;
+	while ((pid = waitpid(-1, &status, 0)) == -1 && errno == EINTR) {
+	}
+	if (pid == -1)
+		return;
+
+	for (int slot = 0; slot < config->jobs; slot++) {
+		if (running[slot].pid != pid)
+			continue;
+		const game_spec_t *game = &games[running[slot].game];
+		game_result_t result;
+		memset(&result, 0, sizeof(result));
+		result.wall_ms = (now_ns() - running[slot].start_ns) / 1e6;
+		parse_output(running[slot].output_fd, game, &result);
+		result.ok = result.ok && WIFEXITED(status) && WEXITSTATUS(status) == 0;
+		result.winner = result.ok ? find_winner(&result, game->players) : -1;
+
+		print_game_row(out, config, game, running[slot].game, &result);
+		add_result(config, game, &result, stats);
+		*failures += !result.ok;
+
+		close(running[slot].output_fd);
+		unlink_namespace(slot);
+		running[slot].pid = 0;
+		break;
+	}
+}
+
+static void print_ranking(FILE *out, const tournament_config_t *config, const binary_stats_t *stats) {
+	fprintf(out, "binary,seats,wins,win_rate,avg_score,avg_valid,avg_invalid\n");
+	for (int i = 0; i < config->binary_count; i++) {
+		// Un binario repetido en la lista aparece una vez con los totales de todas sus entradas
+		bool repeated = false;
+		for (int j = 0; j < i; j++) {
+			repeated = repeated || strcmp(config->binaries[i], config->binaries[j]) == 0;
+		}
+		if (repeated)
+			continue;
+		binary_stats_t total = stats[i];
+		for (int j = i + 1; j < config->binary_count; j++) {
+			if (strcmp(config->binaries[i], config->binaries[j]) == 0) {
+				total.seats += stats[j].seats;
+				total.wins += stats[j].wins;
+				total.score += stats[j].score;
+				total.valid += stats[j].valid;
+				total.invalid += stats[j].invalid;
+			}
+		}
+		double seats = total.seats > 0 ? (double) total.seats : 1.0;
+		fprintf(out, "%s,%llu,%llu,%.4f,%.2f,%.2f,%.2f\n", config->binaries[i], total.seats, total.wins,
+				total.wins / seats, total.score / seats, total.valid / seats, total.invalid / seats);
+	}
+}
+
+int main(int argc, char *argv[]) {
+	tournament_config_t config;
+	if (parse_args(argc, argv, &config) != 0) {
+		usage(argv[0]);
+		return EXIT_FAILURE;
+	}
+
+	game_spec_t *games;
+	int game_count = build_matrix(&config, &games);
+	if (game_count < 0) {
+		perror("Error allocating tournament matrix");
+		return EXIT_FAILURE;
+	}
+
+	FILE *out = (config.games_path != NULL) ? fopen(config.games_path, "w") : stdout;
+	FILE *ranking = (config.ranking_path != NULL) ? fopen(config.ranking_path, "w") : stderr;
+	running_game_t *running = calloc((size_t) config.jobs, sizeof(running_game_t));
+	binary_stats_t *stats = calloc((size_t) config.binary_count, sizeof(binary_stats_t));
+	if (out == NULL || ranking == NULL || running == NULL || stats == NULL) {
+		perror("Error opening tournament outputs");
+		return EXIT_FAILURE;
+	}
+
+	fprintf(out, "game,width,height,players,seed,lineup,scores,winner_seat,winner,status,wall_ms,ready_ms,play_ms,"
+				 "moves\n");
+	unsigned long long start = now_ns();
+	int next = 0, active = 0, failures = 0;
+	while (next < game_count || active > 0) {
+		// Llenar los lugares libres
+		for (int slot = 0; slot < config.jobs && next < game_count; slot++) {
+			if (running[slot].pid != 0)
+				continue;
+			if (spawn_game(&config, &games[next], next, slot, &running[slot]) != 0) {
+				failures++;
+				next++;
+				continue;
+			}
+			next++;
+			active++;
+		}
+		if (active > 0) {
+			reap_game(&config, games, running, out, stats, &failures);
+			active--;
+		}
+	}
+	double seconds = (now_ns() - start) / 1e9;
+
+	print_ranking(ranking, &config, stats);
+	fprintf(stderr, "%d games (%d failed) in %.1f s with %d jobs: %.0f games/hour\n", game_count, failures, seconds,
+			config.jobs, seconds > 0 ? game_count * 3600.0 / seconds : 0.0);
+
+	if (out != stdout) {
+		fclose(out);
+	}
+	if (ranking != stderr) {
+		fclose(ranking);
+	}
+	free(stats);
+	free(running);
+	free(games);
+	free(config.seeds);
+	return failures == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
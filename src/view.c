@@ -1,5 +1,6 @@
 // This is a personal academic project. Dear PVS-Studio, please check it.
 // PVS-Studio Static Code Analyzer for C, C++, C#, and Java: https://pvs-studio.com
+#include "lib/analytics.h"
 #include "lib/common.h"
 #include "lib/library.h"
 #include "lib/view_functions.h"
@@ -7,7 +8,7 @@
 #include <stdio.h>
 #include <stdlib.h>
 
-view_context_t view_ctx = {0};
+view_context_t view_ctx = {.analytics_fd = -1};
 
 /**
  * @brief Wrapper para cleanup del view
@@ -15,6 +16,7 @@ view_context_t view_ctx = {0};
  */
 void view_cleanup_wrapper(void) {
 	close_up(&view_ctx.sync_fd, &view_ctx.state_fd, &view_ctx.game_state, &view_ctx.game_sync);
+	analytics_disconnect(&view_ctx.analytics, &view_ctx.analytics_fd);
 }
 
 /**
@@ -0,0 +1,280 @@
+// This is a personal academic project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: https://pvs-studio.com
+#define _GNU_SOURCE
+#include "../src/lib/analytics.h"
+#include "../src/lib/common.h"
+#include "../src/lib/engine.h"
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+/*
+ * Verificacion del seqlock del analisis (make analytics_check).
+ *
+ * Un thread hace de master: en cada tick cambia celdas al azar, guarda una copia del tablero de ese tick y publica
+ * con analytics_update. Varios lectores conectados como un jugador (analytics_connect, solo lectura) leen sin parar
+ * con analytics_read_summary y analytics_read_regions y comparan lo leido contra un flood fill ingenuo sobre la copia
+ * del tick que devolvio la lectura. Una lectura mezclada de dos ticks no coincide con ninguna copia.
+ */
+
+#define DEFAULT_TICKS 20000
+#define READERS 3
+#define BOARD_WIDTH 24
+#define BOARD_HEIGHT 16
+#define PLAYERS 4
+
+// Copia del tablero publicada en cada tick (indice = tick)
+static game_state_t **history;
+static int ticks;
+static volatile int done;
+
+// Resultado de un lector
+typedef struct {
+	pthread_t thread;	// Thread del lector
+	long reads;			// Lecturas verificadas
+	long mismatches;	// Lecturas que no coinciden con la referencia
+} reader_t;
+
+// Referencia calculada por un lector para un tick
+typedef struct {
+	analytics_summary_t summary;				 // Resumen esperado
+	int labels[BOARD_WIDTH * BOARD_HEIGHT];		 // Region de cada celda (-1 si esta ocupada)
+	analytics_region_t regions[BOARD_WIDTH * BOARD_HEIGHT]; // Regiones esperadas
+} reference_t;
+
+/**
+ * @brief Etiquetado ingenuo de las regiones libres (8 vecinos) y del area alcanzable por cada jugador
+ */
+static void naive_analytics(const game_state_t *state, reference_t *reference) {
+	int cells = state->width * state->height;
+	int queue[BOARD_WIDTH * BOARD_HEIGHT];
+	memset(&reference->summary, 0, sizeof(reference->summary));
+	for (int i = 0; i < cells; i++) {
+		reference->labels[i] = -1;
+	}
+
+	int count = 0;
+	for (int start = 0; start < cells; start++) {
+		if (state->board[start] <= 0 || reference->labels[start] != -1)
+			continue;
+		analytics_region_t *region = &reference->regions[count];
+		memset(region, 0, sizeof(*region));
+		int head = 0, tail = 0;
+		reference->labels[start] = count;
+		queue[tail++] = start;
+		while (head < tail) {
+			int cell = queue[head++];
+			region->cells++;
+			region->reward += (unsigned int) state->board[cell];
+			for (int dir = 0; dir < ENGINE_DIRECTIONS; dir++) {
+				int nx, ny;
+				if (!engine_target(state->board, state->width, state->height, cell % state->width,
+								   cell / state->width, (direction_t) dir, &nx, &ny))
+					continue;
+				int next = ny * state->width + nx;
+				if (reference->labels[next] == -1) {
+					reference->labels[next] = count;
+					queue[tail++] = next;
+				}
+			}
+		}
+		reference->summary.free_cells += region->cells;
+		reference->summary.free_reward += region->reward;
+		if (region->cells > reference->summary.largest_region) {
+			reference->summary.largest_region = region->cells;
+		}
+		count++;
+	}
+	reference->summary.region_count = (unsigned int) count;
+
+	for (unsigned int p = 0; p < state->player_count; p++) {
+		bool seen[BOARD_WIDTH * BOARD_HEIGHT] = {false};
+		for (int dir = 0; dir < ENGINE_DIRECTIONS; dir++) {
+			int nx, ny;
+			if (!engine_target(state->board, state->width, state->height, state->players[p].x, state->players[p].y,
+							   (direction_t) dir, &nx, &ny))
+				continue;
+			int label = reference->labels[ny * state->width + nx];
+			if (seen[label])
+				continue;
+			seen[label] = true;
+			reference->regions[label].player_mask |= (unsigned short) (1u << p);
+			reference->summary.reachable_cells[p] += reference->regions[label].cells;
+			reference->summary.reachable_reward[p] += reference->regions[label].reward;
+		}
+	}
+}
+
+static bool same_region(const analytics_region_t *a, const analytics_region_t *b) {
+	return a->cells == b->cells && a->reward == b->reward && a->player_mask == b->player_mask;
+}
+
+/**
+ * @brief Compara un resumen leido contra la referencia de su tick (sin el tick en si)
+ */
+static bool same_summary(const analytics_summary_t *a, const analytics_summary_t *b) {
+	if (a->region_count != b->region_count || a->free_cells != b->free_cells || a->free_reward != b->free_reward ||
+		a->largest_region != b->largest_region)
+		return false;
+	for (int p = 0; p < MAX_PLAYERS; p++) {
+		if (a->reachable_cells[p] != b->reachable_cells[p] || a->reachable_reward[p] != b->reachable_reward[p])
+			return false;
+	}
+	return true;
+}
+
+/**
+ * @brief Lector: mapea el segmento como un jugador y verifica cada lectura contra la copia de su tick
+ */
+static void *reader_main(void *arg) {
+	reader_t *reader = arg;
+	int fd;
+	const game_analytics_t *analytics = analytics_connect(BOARD_WIDTH, BOARD_HEIGHT, &fd);
+	if (analytics == NULL) {
+		reader->mismatches++;
+		return NULL;
+	}
+
+	int cells[BOARD_WIDTH * BOARD_HEIGHT];
+	for (int i = 0; i < BOARD_WIDTH * BOARD_HEIGHT; i++) {
+		cells[i] = i;
+	}
+	analytics_region_t regions[BOARD_WIDTH * BOARD_HEIGHT];
+	reference_t reference;
+
+	while (!done) {
+		analytics_summary_t summary;
+		analytics_read_summary(analytics, &summary);
+		__sync_synchronize();
+		if (summary.tick < 1 || (int) summary.tick > ticks) {
+			reader->mismatches++;
+		}
+		else {
+			naive_analytics(history[summary.tick], &reference);
+			reader->mismatches += !same_summary(&summary, &reference.summary);
+		}
+
+		unsigned int tick = analytics_read_regions(analytics, cells, BOARD_WIDTH * BOARD_HEIGHT, regions);
+		__sync_synchronize();
+		if (tick < 1 || (int) tick > ticks) {
+			reader->mismatches++;
+			continue;
+		}
+		naive_analytics(history[tick], &reference);
+		for (int i = 0; i < BOARD_WIDTH * BOARD_HEIGHT; i++) {
+			analytics_region_t empty = {0, 0, 0};
+			const analytics_region_t *expected =
+				(reference.labels[i] == -1) ? &empty : &reference.regions[reference.labels[i]];
+			if (!same_region(&regions[i], expected)) {
+				reader->mismatches++;
+				break;
+			}
+		}
+		reader->reads += 2;
+	}
+
+	analytics_disconnect(&analytics, &fd);
+	return NULL;
+}
+
+int main(int argc, char *argv[]) {
+	ticks = (argc > 1 && atoi(argv[1]) > 0) ? atoi(argv[1]) : DEFAULT_TICKS;
+	srand(1);
+
+	// Espacio de nombres propio para no pisar el segmento de una partida en curso
+	char namespace[64];
+	snprintf(namespace, sizeof(namespace), "analytics_check_%d", (int) getpid());
+	setenv(SHM_NAMESPACE_ENV, namespace, 1);
+
+	size_t state_size = sizeof(game_state_t) + (size_t) BOARD_WIDTH * BOARD_HEIGHT * sizeof(int);
+	history = calloc((size_t) ticks + 1, sizeof(game_state_t *));
+	game_state_t *state = calloc(1, state_size);
+	if (history == NULL || state == NULL) {
+		perror("Error allocating board");
+		return EXIT_FAILURE;
+	}
+
+	state->width = BOARD_WIDTH;
+	state->height = BOARD_HEIGHT;
+	state->player_count = PLAYERS;
+	for (int i = 0; i < BOARD_WIDTH * BOARD_HEIGHT; i++) {
+		state->board[i] = 1 + rand() % 9;
+	}
+	for (int p = 0; p < PLAYERS; p++) {
+		int cell = rand() % (BOARD_WIDTH * BOARD_HEIGHT);
+		state->players[p].x = (unsigned short) (cell % BOARD_WIDTH);
+		state->players[p].y = (unsigned short) (cell / BOARD_WIDTH);
+		state->board[cell] = -p;
+	}
+
+	master_context_t ctx;
+	memset(&ctx, 0, sizeof(ctx));
+	ctx.config.width = BOARD_WIDTH;
+	ctx.config.height = BOARD_HEIGHT;
+	ctx.game_state = state;
+
+	// analytics_create publica el tick 1
+	history[1] = malloc(state_size);
+	if (history[1] == NULL) {
+		perror("Error allocating history");
+		return EXIT_FAILURE;
+	}
+	memcpy(history[1], state, state_size);
+	if (analytics_create(&ctx) != 0) {
+		fprintf(stderr, "Error creating analytics\n");
+		return EXIT_FAILURE;
+	}
+
+	reader_t readers[READERS];
+	memset(readers, 0, sizeof(readers));
+	for (int i = 0; i < READERS; i++) {
+		pthread_create(&readers[i].thread, NULL, reader_main, &readers[i]);
+	}
+
+	// Cada tick cambia algunas celdas (sin tocar las de los jugadores) para partir y unir regiones
+	for (int tick = 2; tick <= ticks; tick++) {
+		int changes = 1 + rand() % 8;
+		for (int i = 0; i < changes; i++) {
+			int cell = rand() % (BOARD_WIDTH * BOARD_HEIGHT);
+			if (state->board[cell] > 0) {
+				state->board[cell] = 0;
+			}
+			else if (state->board[cell] == 0 && rand() % 2 == 0) {
+				bool player_cell = false;
+				for (int p = 0; p < PLAYERS; p++) {
+					player_cell = player_cell || state->players[p].y * BOARD_WIDTH + state->players[p].x == cell;
+				}
+				state->board[cell] = player_cell ? 0 : 1 + rand() % 9;
+			}
+		}
+
+		// La copia se guarda antes de publicar: un lector que ve el tick ya la encuentra
+		history[tick] = malloc(state_size);
+		if (history[tick] == NULL) {
+			perror("Error allocating history");
+			return EXIT_FAILURE;
+		}
+		memcpy(history[tick], state, state_size);
+		analytics_update(&ctx);
+	}
+
+	done = 1;
+	long reads = 0, mismatches = 0;
+	for (int i = 0; i < READERS; i++) {
+		pthread_join(readers[i].thread, NULL);
+		reads += readers[i].reads;
+		mismatches += readers[i].mismatches;
+	}
+
+	analytics_destroy(&ctx);
+	for (int tick = 1; tick <= ticks; tick++) {
+		free(history[tick]);
+	}
+	free(history);
+	free(state);
+
+	printf("%d ticks published, %ld reads checked, %ld mismatches\n", ticks, reads, mismatches);
+	return mismatches == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,69 @@
+#!/bin/bash
+# Benchmark de punta a punta: barre tamaño de tablero, cantidad de jugadores y vista on/off
+# Cada combinacion se corre BENCH_REPS veces con semillas fijas (BENCH_SEED + repeticion) y se imprime una fila CSV
+# por corrida con movimientos por segundo (entre el primer y el ultimo movimiento) y la latencia de turno.
+# Con BENCH_SEEDS cada repeticion juega las mismas semillas (una corrida por semilla), asi la diferencia entre
+# repeticiones es solo ruido de la medicion y no de la partida.
+#
+# Uso: ./test/bench.sh [archivo.csv]
+# Variables: BENCH_SIZES, BENCH_PLAYERS, BENCH_VIEW, BENCH_REPS, BENCH_SEED, BENCH_SEEDS, BENCH_PLAYER
+
+MASTER_BIN="./bin/master"
+VIEW_BIN="./bin/view"
+PLAYER_BIN="${BENCH_PLAYER:-./bin/player}"
+
+SIZES="${BENCH_SIZES:-10 20 40}"
+PLAYERS="${BENCH_PLAYERS:-1 3 9}"
+VIEW_MODES="${BENCH_VIEW:-off on}"
+REPS="${BENCH_REPS:-3}"
+SEED="${BENCH_SEED:-1000}"
+OUTPUT="${1:-/dev/stdout}"
+
+if [ ! -x "$MASTER_BIN" ] || [ ! -x "$PLAYER_BIN" ]; then
+    echo "Error: build first with make" >&2
+    exit 1
+fi
+
+LOG=$(mktemp)
+trap 'rm -f "$LOG"' EXIT
+
+echo "size,players,view,rep,seed,moves,game_ms,moves_per_sec,turn_p50_us,turn_p99_us,ready_ms" > "$OUTPUT"
+
+for size in $SIZES; do
+    for players in $PLAYERS; do
+        for view in $VIEW_MODES; do
+            for rep in $(seq 1 "$REPS"); do
+                for seed in ${BENCH_SEEDS:-$((SEED + rep))}; do
+                    player_list=""
+                    for _ in $(seq 1 "$players"); do
+                        player_list="$player_list $PLAYER_BIN"
+                    done
+
+                    view_args=""
+                    if [ "$view" = "on" ]; then
+                        view_args="-v $VIEW_BIN"
+                    fi
+
+                    # Sin retardo: se mide el protocolo, no el sleep entre movimientos
+                    # shellcheck disable=SC2086
+                    "$MASTER_BIN" -w "$size" -h "$size" -d 0 -s "$seed" --latency $view_args -p $player_list \
+                        > "$LOG" 2>/dev/null
+
+                    # Movimientos: suma de (V, I) de los resultados finales
+                    moves=$(grep -oE '\(([0-9]+) V, ([0-9]+) I\)' "$LOG" | tr -d '(),VI' |
+                        awk '{ total += $1 + $2 } END { print total + 0 }')
+                    timing=$(grep '^Startup:' "$LOG" |
+                        sed -E 's/.*ready after ([0-9.]+) ms, first move after ([0-9.]+) ms, last move after ([0-9.]+) ms/\1 \2 \3/')
+                    turn=$(grep -E '^turn ' "$LOG" | awk '{ print $4, $6 }')
+
+                    echo "$size $players $view $rep $seed $moves $timing $turn" | awk '{
+                        game_ms = $9 - $8
+                        rate = (game_ms > 0) ? $6 * 1000 / game_ms : 0
+                        printf "%s,%s,%s,%s,%s,%s,%.3f,%.0f,%s,%s,%s\n", $1, $2, $3, $4, $5, $6, game_ms, rate, \
+                            $10, $11, $7
+                    }' >> "$OUTPUT"
+                done
+            done
+        done
+    done
+done
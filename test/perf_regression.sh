@@ -0,0 +1,158 @@
+#!/bin/bash
+# Control de regresiones de rendimiento contra una linea base guardada.
+# Corre un conjunto fijo de partidas sin vista (via bench.sh) y el benchmark del transporte actual
+# (ipc_bench -t pipe), PERF_REPS veces cada escenario. Cada repeticion juega las mismas semillas (PERF_SEEDS) y aporta
+# una muestra con el promedio de esas partidas, asi el intervalo de confianza del 95% (t de Student) mide el ruido de
+# la medicion y no la diferencia entre partidas. Compara cada media con la linea base: falla si empeora mas que el
+# umbral y la linea base queda fuera del intervalo (si queda dentro se informa NOISY: conviene subir PERF_REPS).
+#
+# Metricas: moves_per_sec (mayor es mejor), turn_p99_us y startup_ms (menor es mejor).
+#
+# Uso: ./test/perf_regression.sh [--update]
+#   --update  Reescribe la linea base con esta corrida (unica forma de actualizarla)
+# Variables:
+#   PERF_BASELINE            Archivo de linea base (default: test/perf_baseline.csv)
+#   PERF_REPS                Repeticiones por escenario (default: 5)
+#   PERF_SEEDS               Semillas que juega cada repeticion (default: "2001 2002 2003")
+#   PERF_THRESHOLD           Empeoramiento maximo en % para todas las metricas (default: 20)
+#   PERF_THRESHOLD_MOVES     Umbral de moves_per_sec (default: PERF_THRESHOLD)
+#   PERF_THRESHOLD_P99       Umbral de turn_p99_us (default: PERF_THRESHOLD)
+#   PERF_THRESHOLD_STARTUP   Umbral de startup_ms (default: PERF_THRESHOLD)
+#
+# Sin linea base la corrida se graba como linea base (se informa) y no se compara.
+# Salida: 0 sin regresiones (o linea base grabada), 1 con regresiones.
+
+cd "$(dirname "$0")/.." || exit 1
+
+BASELINE="${PERF_BASELINE:-test/perf_baseline.csv}"
+REPS="${PERF_REPS:-5}"
+SEEDS="${PERF_SEEDS:-2001 2002 2003}"
+THRESHOLD="${PERF_THRESHOLD:-20}"
+THRESHOLD_MOVES="${PERF_THRESHOLD_MOVES:-$THRESHOLD}"
+THRESHOLD_P99="${PERF_THRESHOLD_P99:-$THRESHOLD}"
+THRESHOLD_STARTUP="${PERF_THRESHOLD_STARTUP:-$THRESHOLD}"
+IPC_MOVES=20000
+
+# Escenarios de partidas: nombre, lado del tablero y cantidad de jugadores
+GAME_SCENARIOS="game_10x10_p3 10 3
+game_20x20_p9 20 9
+game_40x40_p9 40 9"
+
+UPDATE=0
+case "$1" in
+    --update) UPDATE=1 ;;
+    "") ;;
+    *)
+        echo "Uso: ./test/perf_regression.sh [--update]" >&2
+        exit 1
+        ;;
+esac
+
+if [ ! -x ./bin/master ] || [ ! -x ./bin/player ] || [ ! -x ./bin/ipc_bench ]; then
+    echo "Error: build first with make perf" >&2
+    exit 1
+fi
+
+# Imprime un CSV de medias como tabla
+print_table() {
+    awk -F, '{ printf "%-16s %-14s %14s %12s %5s\n", $1, $2, $3, $4, $5 }' "$1"
+}
+
+SAMPLES=$(mktemp)
+CURRENT=$(mktemp)
+RUN_CSV=$(mktemp)
+trap 'rm -f "$SAMPLES" "$CURRENT" "$RUN_CSV"' EXIT
+
+# Muestras: una fila "escenario,metrica,valor" por repeticion (promedio de las semillas de esa repeticion)
+while read -r name size players; do
+    echo "Running $name ($REPS runs of seeds $SEEDS)..." >&2
+    BENCH_SIZES="$size" BENCH_PLAYERS="$players" BENCH_VIEW=off BENCH_REPS="$REPS" BENCH_SEEDS="$SEEDS" \
+        ./test/bench.sh "$RUN_CSV"
+    tail -n +2 "$RUN_CSV" | awk -F, -v name="$name" '
+    $8 != "" && $10 != "" && $11 != "" {
+        if (!($4 in n)) order[++reps] = $4
+        n[$4]++; moves[$4] += $8; p99[$4] += $10; startup[$4] += $11
+    }
+    END {
+        for (i = 1; i <= reps; i++) {
+            rep = order[i]
+            printf "%s,moves_per_sec,%.3f\n", name, moves[rep] / n[rep]
+            printf "%s,turn_p99_us,%.3f\n", name, p99[rep] / n[rep]
+            printf "%s,startup_ms,%.3f\n", name, startup[rep] / n[rep]
+        }
+    }' >> "$SAMPLES"
+done <<< "$GAME_SCENARIOS"
+
+echo "Running ipc_pipe_p9 ($REPS runs)..." >&2
+for _ in $(seq 1 "$REPS"); do
+    ./bin/ipc_bench -t pipe -m "$IPC_MOVES" 9 | tail -n 1 | awk -F, '{
+        print "ipc_pipe_p9,moves_per_sec," $4
+        print "ipc_pipe_p9,turn_p99_us," $8
+    }' >> "$SAMPLES"
+done
+
+# Media, desvio e intervalo de confianza del 95% por escenario y metrica (en el orden en que se corrieron)
+awk -F, '
+function t95(df) {
+    # Valores criticos de t de Student a dos colas; para mas de 30 grados de libertad se usa la normal
+    split("12.706 4.303 3.182 2.776 2.571 2.447 2.365 2.306 2.262 2.228 2.201 2.179 2.160 2.145 2.131 " \
+          "2.120 2.110 2.101 2.093 2.086 2.080 2.074 2.069 2.064 2.060 2.056 2.052 2.048 2.045 2.042", t, " ")
+    return (df <= 30) ? t[df] : 1.960
+}
+$3 == "" { next }
+{
+    key = $1 "," $2
+    if (!(key in n)) order[++keys] = key
+    n[key]++; sum[key] += $3; sq[key] += $3 * $3
+}
+END {
+    print "scenario,metric,mean,ci95,runs"
+    for (i = 1; i <= keys; i++) {
+        key = order[i]
+        mean = sum[key] / n[key]
+        var = (n[key] > 1) ? (sq[key] - n[key] * mean * mean) / (n[key] - 1) : 0
+        ci = (n[key] > 1 && var > 0) ? t95(n[key] - 1) * sqrt(var / n[key]) : 0
+        printf "%s,%.3f,%.3f,%d\n", key, mean, ci, n[key]
+    }
+}' "$SAMPLES" > "$CURRENT"
+
+if [ "$UPDATE" -eq 1 ]; then
+    cp "$CURRENT" "$BASELINE"
+    echo "Baseline updated: $BASELINE"
+    print_table "$BASELINE"
+    exit 0
+fi
+
+# Primera corrida en una maquina: no hay contra que comparar, se graba esta como linea base
+if [ ! -f "$BASELINE" ]; then
+    cp "$CURRENT" "$BASELINE"
+    echo "No baseline at $BASELINE: recorded this run as the baseline (nothing compared)" >&2
+    print_table "$BASELINE"
+    exit 0
+fi
+
+# Comparacion: el cambio se expresa como empeoramiento en % (negativo si mejoro)
+awk -F, -v t_moves="$THRESHOLD_MOVES" -v t_p99="$THRESHOLD_P99" -v t_startup="$THRESHOLD_STARTUP" '
+BEGIN {
+    printf "%-16s %-14s %12s %12s    %-10s %8s  %s\n", "Scenario", "Metric", "Baseline", "Mean", "CI95", "Worse", "Status"
+}
+FNR == 1 { next }
+NR == FNR { base[$1 "," $2] = $3; next }
+{
+    key = $1 "," $2
+    if (!(key in base) || base[key] == 0) {
+        printf "%-16s %-14s %12s %12.3f +- %-10.3f %8s  %s\n", $1, $2, "-", $3, $4, "-", "NEW"
+        next
+    }
+    worse = ($2 == "moves_per_sec") ? (base[key] - $3) / base[key] * 100 : ($3 - base[key]) / base[key] * 100
+    limit = ($2 == "moves_per_sec") ? t_moves : ($2 == "turn_p99_us") ? t_p99 : t_startup
+    # Solo cuenta si ademas la linea base queda fuera del intervalo de confianza de esta corrida
+    diff = ($3 > base[key]) ? $3 - base[key] : base[key] - $3
+    status = (worse <= limit) ? "OK" : (diff > $4) ? "REGRESSION" : "NOISY"
+    regressions += (status == "REGRESSION")
+    printf "%-16s %-14s %12.3f %12.3f +- %-10.3f %+7.1f%%  %s\n", $1, $2, base[key], $3, $4, worse, status
+}
+END {
+    printf "\n%d regression(s)\n", regressions
+    exit (regressions > 0)
+}' "$BASELINE" "$CURRENT"
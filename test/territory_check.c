@@ -0,0 +1,233 @@
+// This is a personal academic project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: https://pvs-studio.com
+#include "../src/lib/common.h"
+#include "../src/lib/engine.h"
+#include "../src/lib/territory.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/*
+ * Verificacion del evaluador de territorio (make territory_check).
+ *
+ * Juega partidas aleatorias sobre tableros de distintos tamaños (incluidos anchos que cruzan palabras de 64 bits) y
+ * radios, y despues de cada observacion compara territory_evaluate y territory_evaluate_move (para cada movimiento
+ * posible de cada jugador) contra un BFS ingenuo por jugador sobre enteros. Asi se ejercitan la carga incremental,
+ * la correccion de los campos por celdas ocupadas y el uso de los campos de los rivales sin corregir al simular un
+ * movimiento.
+ */
+
+#define DEFAULT_BOARDS 200
+#define MOVES_PER_BOARD 24
+
+static int *distance[MAX_PLAYERS];
+static int *queue;
+
+/**
+ * @brief BFS ingenuo desde una posicion sobre las celdas libres (board > 0), hasta radius pasos
+ */
+static void naive_bfs(const game_state_t *state, int radius, int sx, int sy, int *dist) {
+	int cells = state->width * state->height;
+	for (int i = 0; i < cells; i++) {
+		dist[i] = -1;
+	}
+	int head = 0, tail = 0;
+	dist[sy * state->width + sx] = 0;
+	queue[tail++] = sy * state->width + sx;
+	while (head < tail) {
+		int cell = queue[head++];
+		if (dist[cell] == radius)
+			continue;
+		for (int dir = 0; dir < ENGINE_DIRECTIONS; dir++) {
+			int dx, dy;
+			engine_direction_offset((direction_t) dir, &dx, &dy);
+			int nx = cell % state->width + dx, ny = cell / state->width + dy;
+			if (nx < 0 || ny < 0 || nx >= state->width || ny >= state->height)
+				continue;
+			int next = ny * state->width + nx;
+			if (state->board[next] > 0 && dist[next] == -1) {
+				dist[next] = dist[cell] + 1;
+				queue[tail++] = next;
+			}
+		}
+	}
+}
+
+/**
+ * @brief Territorio de referencia: cada celda es del unico jugador con la menor distancia
+ */
+static void naive_evaluate(const game_state_t *state, int radius, territory_result_t *result) {
+	memset(result, 0, sizeof(*result));
+	for (unsigned int p = 0; p < state->player_count; p++) {
+		if (!state->players[p].is_blocked) {
+			naive_bfs(state, radius, state->players[p].x, state->players[p].y, distance[p]);
+		}
+	}
+
+	for (int cell = 0; cell < state->width * state->height; cell++) {
+		int best = -1, owner = -1;
+		for (unsigned int p = 0; p < state->player_count; p++) {
+			int d = state->players[p].is_blocked ? -1 : distance[p][cell];
+			if (d <= 0)
+				continue;
+			if (best == -1 || d < best) {
+				best = d;
+				owner = (int) p;
+			}
+			else if (d == best) {
+				owner = -1;
+			}
+		}
+		if (owner >= 0) {
+			result->cells[owner]++;
+			result->reward[owner] += (unsigned int) state->board[cell];
+		}
+	}
+}
+
+static bool same_result(const territory_result_t *a, const territory_result_t *b, unsigned int players) {
+	for (unsigned int p = 0; p < players; p++) {
+		if (a->cells[p] != b->cells[p] || a->reward[p] != b->reward[p])
+			return false;
+	}
+	return true;
+}
+
+/**
+ * @brief Compara la evaluacion actual y la de cada movimiento posible contra el BFS ingenuo
+ * @return Cantidad de diferencias
+ */
+static int check_state(territory_t *territory, game_state_t *state, int radius, int board) {
+	int failures = 0;
+	territory_result_t expected, actual;
+
+	naive_evaluate(state, radius, &expected);
+	territory_evaluate(territory, &actual);
+	if (!same_result(&expected, &actual, state->player_count)) {
+		fprintf(stderr, "board %d (%dx%d, radius %d): evaluate differs\n", board, state->width, state->height,
+				radius);
+		failures++;
+	}
+
+	for (unsigned int p = 0; p < state->player_count; p++) {
+		if (state->players[p].is_blocked)
+			continue;
+		for (int dir = 0; dir < ENGINE_DIRECTIONS; dir++) {
+			int dx, dy;
+			engine_direction_offset((direction_t) dir, &dx, &dy);
+			int x = state->players[p].x, y = state->players[p].y;
+			int nx = x + dx, ny = y + dy;
+			if (nx < 0 || ny < 0 || nx >= state->width || ny >= state->height ||
+				state->board[ny * state->width + nx] <= 0)
+				continue;
+
+			// Referencia: el jugador en el destino y la celda ocupada
+			int value = state->board[ny * state->width + nx];
+			state->board[ny * state->width + nx] = -(int) p;
+			state->players[p].x = (unsigned short) nx;
+			state->players[p].y = (unsigned short) ny;
+			naive_evaluate(state, radius, &expected);
+			state->players[p].x = (unsigned short) x;
+			state->players[p].y = (unsigned short) y;
+			state->board[ny * state->width + nx] = value;
+
+			territory_evaluate_move(territory, (int) p, nx, ny, &actual);
+			if (!same_result(&expected, &actual, state->player_count)) {
+				fprintf(stderr, "board %d (%dx%d, radius %d): move of player %u to (%d,%d) differs\n", board,
+						state->width, state->height, radius, p, nx, ny);
+				failures++;
+			}
+		}
+	}
+
+	// Despues de simular los movimientos el evaluador tiene que haber quedado igual
+	naive_evaluate(state, radius, &expected);
+	territory_evaluate(territory, &actual);
+	if (!same_result(&expected, &actual, state->player_count)) {
+		fprintf(stderr, "board %d: evaluate differs after simulated moves\n", board);
+		failures++;
+	}
+	return failures;
+}
+
+/**
+ * @brief Mueve un jugador a una celda libre vecina al azar (o lo bloquea si no tiene)
+ */
+static void random_move(game_state_t *state, int player_id) {
+	player_t *player = &state->players[player_id];
+	int options[ENGINE_DIRECTIONS], count = 0;
+	for (int dir = 0; dir < ENGINE_DIRECTIONS; dir++) {
+		int dx, dy;
+		engine_direction_offset((direction_t) dir, &dx, &dy);
+		int nx = player->x + dx, ny = player->y + dy;
+		if (nx >= 0 && ny >= 0 && nx < state->width && ny < state->height && state->board[ny * state->width + nx] > 0)
+			options[count++] = ny * state->width + nx;
+	}
+	if (count == 0) {
+		player->is_blocked = true;
+		return;
+	}
+	int cell = options[rand() % count];
+	player->score += (unsigned int) state->board[cell];
+	player->valid_moves++;
+	state->board[cell] = -player_id;
+	player->x = (unsigned short) (cell % state->width);
+	player->y = (unsigned short) (cell / state->width);
+}
+
+int main(int argc, char *argv[]) {
+	int boards = (argc > 1 && atoi(argv[1]) > 0) ? atoi(argv[1]) : DEFAULT_BOARDS;
+	int failures = 0;
+	srand(1);
+
+	for (int board = 0; board < boards; board++) {
+		int width = 10 + rand() % 140, height = 10 + rand() % 30;
+		int players = 1 + rand() % MAX_PLAYERS;
+		int radius = 1 + rand() % 80;
+
+		game_state_t *state = calloc(1, sizeof(game_state_t) + (size_t) width * height * sizeof(int));
+		queue = malloc((size_t) width * height * sizeof(int));
+		for (int p = 0; p < MAX_PLAYERS; p++) {
+			distance[p] = malloc((size_t) width * height * sizeof(int));
+		}
+		territory_t territory;
+		if (state == NULL || queue == NULL || territory_create(&territory, width, height, radius) != 0) {
+			perror("Error allocating board");
+			return EXIT_FAILURE;
+		}
+
+		// Tablero con recompensas y un porcentaje de celdas ya ocupadas
+		state->width = (unsigned short) width;
+		state->height = (unsigned short) height;
+		state->player_count = (unsigned int) players;
+		int walls = rand() % 40;
+		for (int i = 0; i < width * height; i++) {
+			state->board[i] = (rand() % 100 < walls) ? 0 : 1 + rand() % 9;
+		}
+		for (int p = 0; p < players; p++) {
+			int cell = rand() % (width * height);
+			state->players[p].x = (unsigned short) (cell % width);
+			state->players[p].y = (unsigned short) (cell / width);
+			state->board[cell] = -p;
+		}
+
+		// Se observa el estado cada algunos movimientos para ejercitar la carga incremental
+		for (int move = 0; move < MOVES_PER_BOARD; move++) {
+			if (move % 4 == 0) {
+				territory_sync(&territory, state);
+				failures += check_state(&territory, state, territory.radius, board);
+			}
+			random_move(state, move % players);
+		}
+
+		territory_destroy(&territory);
+		for (int p = 0; p < MAX_PLAYERS; p++) {
+			free(distance[p]);
+		}
+		free(queue);
+		free(state);
+	}
+
+	printf("%d boards checked, %d mismatches\n", boards, failures);
+	return failures == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}